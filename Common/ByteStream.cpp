@@ -1,4 +1,5 @@
 #include <codecvt>
+#include <cstring>
 #include "ByteStream.h"
 #include <span>
 
@@ -6,29 +7,39 @@ ByteBuffer::ByteBuffer( const std::vector< uint8_t > &data )
 {
 	this->m_buffer = data;
 	this->m_position = 0;
+	this->m_valid = true;
+	this->m_cipherCache = nullptr;
 }
 
 ByteBuffer::ByteBuffer( const std::string &data )
 {
 	this->m_buffer = std::vector< uint8_t >( data.begin(), data.end() );
 	this->m_position = 0;
+	this->m_valid = true;
+	this->m_cipherCache = nullptr;
 }
 
 ByteBuffer::ByteBuffer( const uint8_t *data, uint32_t length )
 {
 	this->m_buffer = std::vector< uint8_t >( data, data + length );
 	this->m_position = 0;
+	this->m_valid = true;
+	this->m_cipherCache = nullptr;
 }
 
 ByteBuffer::ByteBuffer( uint32_t length )
 {
 	this->m_buffer = std::vector< uint8_t >( length, 0 );
 	this->m_position = 0;
+	this->m_valid = true;
+	this->m_cipherCache = nullptr;
 }
 
 ByteBuffer::ByteBuffer()
 {
 	this->m_position = 0;
+	this->m_valid = true;
+	this->m_cipherCache = nullptr;
 }
 
 ByteBuffer::~ByteBuffer()
@@ -54,12 +65,13 @@ void ByteBuffer::write( T value )
 template < typename T >
 T ByteBuffer::read()
 {
-	if( m_position >= m_buffer.size() )
+	if( !require( sizeof( T ) ) )
 	{
 		return (T)0;
 	}
 
-	T value = *( T * )&m_buffer[ m_position ];
+	T value;
+	std::memcpy( &value, &m_buffer[ m_position ], sizeof( T ) );
 	m_position += sizeof( T );
 
 	return value;
@@ -91,13 +103,7 @@ void ByteBuffer::write_utf8( const std::string &str, std::optional<uint32_t> len
 void ByteBuffer::write_utf16( const std::wstring &str, std::optional<uint32_t> length )
 {
 	write_u32( static_cast< uint32_t >( str.size() ) );
-
-	for( wchar_t ch : str )
-	{
-		uint16_t val = static_cast< uint16_t >( ch );
-		write<uint8_t>( val & 0xFF );
-		write<uint8_t>( ( val >> 8 ) & 0xFF );
-	}
+	write_bytes( reinterpret_cast< const uint8_t * >( str.data() ), static_cast< uint32_t >( str.size() * 2 ) );
 }
 
 void ByteBuffer::write_sz_utf8( const std::string &str, std::optional<uint32_t> length )
@@ -116,12 +122,7 @@ void ByteBuffer::write_sz_utf8( const std::string &str, std::optional<uint32_t>
 
 void ByteBuffer::write_sz_utf16( const std::wstring &str, std::optional<uint32_t> length )
 {
-	for( wchar_t ch : str )
-	{
-		uint16_t val = static_cast< uint16_t >( ch );
-		write<uint8_t>( val & 0xFF );
-		write<uint8_t>( ( val >> 8 ) & 0xFF );
-	}
+	write_bytes( reinterpret_cast< const uint8_t * >( str.data() ), static_cast< uint32_t >( str.size() * 2 ) );
 
 	if( length )
 	{
@@ -151,12 +152,7 @@ void ByteBuffer::write_encrypted_utf8( const std::string &str )
 
 void ByteBuffer::write_encrypted_utf16( const std::wstring &str )
 {
-	std::vector< uint8_t > utf16;
-	for( auto c : str )
-	{
-		utf16.push_back( c & 0xFF );
-		utf16.push_back( ( c >> 8 ) & 0xFF );
-	}
+	std::span< const uint8_t > utf16( reinterpret_cast< const uint8_t * >( str.data() ), str.size() * 2 );
 
 	auto encrypted = RealmCrypt::encryptSymmetric( utf16 );
 	uint32_t encryptedLength = static_cast< uint32_t >( encrypted.size() );
@@ -169,6 +165,17 @@ void ByteBuffer::write_encrypted_utf16( const std::wstring &str )
 	write_bytes( encrypted );
 }
 
+void ByteBuffer::write_encrypted_utf16( const CachedCipherText &str )
+{
+	uint32_t encryptedLength = static_cast< uint32_t >( str.cipher.size() );
+	uint32_t decryptedLength = static_cast< uint32_t >( str.plain.size() * 2 );
+
+	write_u32( ( encryptedLength + 4 ) / 2 );
+	write_u32( decryptedLength );
+
+	write_bytes( str.cipher );
+}
+
 uint8_t ByteBuffer::read_u8()
 {
 	return read< uint8_t >();
@@ -211,9 +218,9 @@ std::string ByteBuffer::read_utf8( std::optional<uint32_t> length )
 		length = read_u32();
 	}
 
-	if( m_position + length.value() > m_buffer.size() )
+	if( !require( length.value() ) )
 	{
-		throw std::runtime_error( "read_utf8: Attempt to read past end of buffer" );
+		return "";
 	}
 
 	std::string value( reinterpret_cast< const char * >( &m_buffer[ m_position ] ), length.value() );
@@ -229,21 +236,15 @@ std::wstring ByteBuffer::read_utf16( std::optional<uint32_t> length )
 		length = read_u32();
 	}
 
-	uint32_t byteLength = length.value() * 2;
+	size_t byteLength = static_cast< size_t >( length.value() ) * 2;
 
-	if( m_position + byteLength > m_buffer.size() )
+	if( !require( byteLength ) )
 	{
-		throw std::runtime_error( "read_utf16: Attempt to read past end of buffer" );
+		return L"";
 	}
 
-	std::wstring value;
-	value.reserve( length.value() );
-
-	for( size_t i = 0; i < byteLength; i += 2 )
-	{
-		uint16_t ch = m_buffer[ m_position + i ] | ( m_buffer[ m_position + i + 1 ] << 8 );
-		value.push_back( static_cast< wchar_t >( ch ) );
-	}
+	std::wstring value( length.value(), L'\0' );
+	std::memcpy( value.data(), m_buffer.data() + m_position, byteLength );
 
 	m_position += byteLength;
 	return value;
@@ -252,12 +253,17 @@ std::wstring ByteBuffer::read_utf16( std::optional<uint32_t> length )
 std::string ByteBuffer::read_sz_utf8()
 {
 	std::string value;
-	while( m_buffer[ m_position ] != 0 )
+	while( require( 1 ) && m_buffer[ m_position ] != 0 )
 	{
 		value.push_back( m_buffer[ m_position ] );
 		m_position++;
 	}
 
+	if( !m_valid )
+	{
+		return "";
+	}
+
 	m_position++;
 
 	return value;
@@ -265,14 +271,22 @@ std::string ByteBuffer::read_sz_utf8()
 
 std::wstring ByteBuffer::read_sz_utf16()
 {
-	std::wstring value;
-	while( m_buffer[ m_position ] != 0 || m_buffer[ m_position + 1 ] != 0 )
+	// Find the terminator, then copy everything before it in one go.
+	size_t end = m_position;
+	while( end + 2 <= m_buffer.size() && ( m_buffer[ end ] != 0 || m_buffer[ end + 1 ] != 0 ) )
+	{
+		end += 2;
+	}
+
+	if( !require( end - m_position + 2 ) )
 	{
-		value.push_back( m_buffer[ m_position ] | ( m_buffer[ m_position + 1 ] << 8 ) );
-		m_position += 2;
+		return L"";
 	}
 
-	m_position += 2;
+	std::wstring value( ( end - m_position ) / 2, L'\0' );
+	std::memcpy( value.data(), m_buffer.data() + m_position, end - m_position );
+
+	m_position = end + 2;
 
 	return value;
 }
@@ -287,6 +301,11 @@ std::string ByteBuffer::read_encrypted_utf8( bool hasBlockLength )
 		uint32_t blockLength = read_u32() * 2;
 		decryptedLength = read_u32();
 		encryptedLength = blockLength - 4;
+
+		if( blockLength < 4 )
+		{
+			m_valid = false;
+		}
 	}
 	else
 	{
@@ -294,6 +313,16 @@ std::string ByteBuffer::read_encrypted_utf8( bool hasBlockLength )
 		encryptedLength = Util::round_up( decryptedLength, 16 );
 	}
 
+	if( encryptedLength % 16 != 0 || decryptedLength > encryptedLength )
+	{
+		m_valid = false;
+	}
+
+	if( !require( encryptedLength ) )
+	{
+		return "";
+	}
+
 	std::span< const uint8_t > encryptedBuffer( m_buffer.data() + m_position, encryptedLength );
 
 	m_position += encryptedLength;
@@ -306,7 +335,7 @@ std::string ByteBuffer::read_encrypted_utf8( bool hasBlockLength )
 	// Decrypt the buffer
 	std::vector< uint8_t > decryptedBuffer = RealmCrypt::decryptSymmetric( encryptedBuffer );
 
-	std::string result( decryptedBuffer.begin(), decryptedBuffer.end() );
+	std::string result( decryptedBuffer.begin(), decryptedBuffer.begin() + decryptedLength );
 
 	return result;
 }
@@ -321,6 +350,11 @@ std::wstring ByteBuffer::read_encrypted_utf16( bool hasBlockLength )
 		uint32_t blockLength = read_u32() * 2;
 		decryptedLength = read_u32();	// This length is already multiplied by sizeof(wchar_t)
 		encryptedLength = blockLength - 4;
+
+		if( blockLength < 4 )
+		{
+			m_valid = false;
+		}
 	}
 	else
 	{
@@ -328,6 +362,16 @@ std::wstring ByteBuffer::read_encrypted_utf16( bool hasBlockLength )
 		encryptedLength = Util::round_up( decryptedLength, 16 );
 	}
 
+	if( encryptedLength % 16 != 0 || decryptedLength > encryptedLength || decryptedLength % 2 != 0 )
+	{
+		m_valid = false;
+	}
+
+	if( !require( encryptedLength ) )
+	{
+		return L"";
+	}
+
 	std::span< const uint8_t > encryptedBuffer( m_buffer.data() + m_position, encryptedLength );
 
 	m_position += encryptedLength;
@@ -337,6 +381,14 @@ std::wstring ByteBuffer::read_encrypted_utf16( bool hasBlockLength )
 		return L"";
 	}
 
+	if( m_cipherCache
+		&& encryptedLength == m_cipherCache->cipher.size()
+		&& decryptedLength == m_cipherCache->plain.size() * 2
+		&& std::memcmp( encryptedBuffer.data(), m_cipherCache->cipher.data(), encryptedLength ) == 0 )
+	{
+		return m_cipherCache->plain;
+	}
+
 	// Decrypt the buffer
 	std::vector< uint8_t > decryptedBuffer = RealmCrypt::decryptSymmetric( encryptedBuffer );
 
@@ -348,13 +400,13 @@ std::wstring ByteBuffer::read_encrypted_utf16( bool hasBlockLength )
 
 void ByteBuffer::write_bytes( const std::vector< uint8_t > &value )
 {
-	std::copy( value.begin(), value.end(), std::back_inserter( m_buffer ) );
+	m_buffer.insert( m_buffer.end(), value.begin(), value.end() );
 	m_position += value.size();
 }
 
 void ByteBuffer::write_bytes( const uint8_t *value, uint32_t length )
 {
-	std::copy( value, value + length, std::back_inserter( m_buffer ) );
+	m_buffer.insert( m_buffer.end(), value, value + length );
 	m_position += length;
 }
 
@@ -370,6 +422,11 @@ void ByteBuffer::write_encrypted_bytes( const std::vector<uint8_t> &value )
 
 std::vector<uint8_t> ByteBuffer::read_bytes( uint32_t length )
 {
+	if( !require( length ) )
+	{
+		return {};
+	}
+
 	std::vector<uint8_t> value( length, 0 );
 
 	std::copy( m_buffer.begin() + m_position, m_buffer.begin() + m_position + length, value.begin() );
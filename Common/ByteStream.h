@@ -35,6 +35,26 @@ public:
 		}
 	}
 
+	// Reads never throw. Running past the end of the buffer, or reading a
+	// length prefix that does not fit, marks the stream invalid and every
+	// read after that returns an empty value. Callers check is_valid() once
+	// after they are done decoding.
+	bool is_valid() const
+	{
+		return m_valid;
+	}
+
+	// Bounds check a fixed-size run of reads up front.
+	bool require( size_t length )
+	{
+		if( !m_valid || length > m_buffer.size() - m_position )
+		{
+			m_valid = false;
+		}
+
+		return m_valid;
+	}
+
 	void write_u8( uint8_t value );
 	void write_u16( uint16_t value );
 	void write_u32( uint32_t value );
@@ -49,6 +69,7 @@ public:
 	void write_sz_utf16( const std::wstring &str, std::optional<uint32_t> length = std::nullopt );
 	void write_encrypted_utf8( const std::string &str );
 	void write_encrypted_utf16( const std::wstring &str );
+	void write_encrypted_utf16( const CachedCipherText &str );
 
 	uint8_t read_u8();
 	uint16_t read_u16();
@@ -80,6 +101,11 @@ public:
 
 	std::vector< uint8_t > m_buffer;
 	size_t m_position;
+	bool m_valid;
+
+	// Ciphertext that read_encrypted_utf16 can answer with a compare instead
+	// of a decrypt. Points at the owning connection's session ID.
+	const CachedCipherText *m_cipherCache;
 };
 
 typedef std::shared_ptr< ByteBuffer > sptr_byte_stream;
\ No newline at end of file
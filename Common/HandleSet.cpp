@@ -0,0 +1,91 @@
+#include "HandleSet.h"
+
+bool HandleSet::Insert( uint32_t id )
+{
+	if( id == 0 )
+	{
+		return false;
+	}
+
+	if( ( m_size + 1 ) * 2 > m_slots.size() )
+	{
+		Rehash( m_slots.empty() ? 16 : m_slots.size() * 2 );
+	}
+
+	const size_t mask = m_slots.size() - 1;
+	size_t i = Home( id, mask );
+
+	while( m_slots[ i ] != 0 )
+	{
+		if( m_slots[ i ] == id )
+		{
+			return false;
+		}
+
+		i = ( i + 1 ) & mask;
+	}
+
+	m_slots[ i ] = id;
+	m_size++;
+
+	return true;
+}
+
+bool HandleSet::Erase( uint32_t id )
+{
+	if( id == 0 || m_size == 0 )
+	{
+		return false;
+	}
+
+	const size_t mask = m_slots.size() - 1;
+	size_t i = Home( id, mask );
+
+	while( m_slots[ i ] != id )
+	{
+		if( m_slots[ i ] == 0 )
+		{
+			return false;
+		}
+
+		i = ( i + 1 ) & mask;
+	}
+
+	// Pull back any later entry in the run that may live in the gap.
+	for( size_t j = ( i + 1 ) & mask; m_slots[ j ] != 0; j = ( j + 1 ) & mask )
+	{
+		const size_t home = Home( m_slots[ j ], mask );
+		if( ( ( j - home ) & mask ) >= ( ( j - i ) & mask ) )
+		{
+			m_slots[ i ] = m_slots[ j ];
+			i = j;
+		}
+	}
+
+	m_slots[ i ] = 0;
+	m_size--;
+
+	return true;
+}
+
+void HandleSet::Clear()
+{
+	m_slots.clear();
+	m_size = 0;
+}
+
+void HandleSet::Rehash( size_t capacity )
+{
+	auto old = std::move( m_slots );
+
+	m_slots.assign( capacity, 0 );
+	m_size = 0;
+
+	for( const auto id : old )
+	{
+		if( id != 0 )
+		{
+			Insert( id );
+		}
+	}
+}
\ No newline at end of file
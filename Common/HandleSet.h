@@ -0,0 +1,55 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// Open-addressing set of interned IDs (see StringInterner). Linear probing
+// over a power-of-two table kept at most half full; erase shifts the
+// following run back so no tombstones are needed. ID 0 marks an empty
+// slot and is never stored.
+class HandleSet
+{
+public:
+	bool Insert( uint32_t id );
+	bool Erase( uint32_t id );
+	void Clear();
+
+	bool Contains( uint32_t id ) const
+	{
+		if( id == 0 || m_size == 0 )
+		{
+			return false;
+		}
+
+		const size_t mask = m_slots.size() - 1;
+		for( size_t i = Home( id, mask );; i = ( i + 1 ) & mask )
+		{
+			if( m_slots[ i ] == id )
+			{
+				return true;
+			}
+
+			if( m_slots[ i ] == 0 )
+			{
+				return false;
+			}
+		}
+	}
+
+	size_t Size() const
+	{
+		return m_size;
+	}
+
+private:
+	static size_t Home( uint32_t id, size_t mask )
+	{
+		return static_cast< size_t >( id * 2654435769u ) & mask;
+	}
+
+	void Rehash( size_t capacity );
+
+	std::vector< uint32_t > m_slots;
+	size_t m_size = 0;
+};
\ No newline at end of file
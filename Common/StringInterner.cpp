@@ -0,0 +1,32 @@
+#include "StringInterner.h"
+
+uint32_t StringInterner::Intern( const std::wstring &value )
+{
+	auto [ it, inserted ] = m_ids.try_emplace( value, 0 );
+	if( inserted )
+	{
+		// Node keys never move, so the table can point at them directly.
+		m_strings.push_back( &it->first );
+		it->second = static_cast< uint32_t >( m_strings.size() );
+	}
+
+	return it->second;
+}
+
+uint32_t StringInterner::Find( const std::wstring &value ) const
+{
+	auto it = m_ids.find( value );
+	return ( it != m_ids.end() ) ? it->second : INVALID_ID;
+}
+
+const std::wstring &StringInterner::Lookup( uint32_t id ) const
+{
+	static const std::wstring empty;
+
+	if( id == INVALID_ID || id > m_strings.size() )
+	{
+		return empty;
+	}
+
+	return *m_strings[ id - 1 ];
+}
\ No newline at end of file
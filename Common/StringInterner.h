@@ -0,0 +1,39 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+// Maps strings such as chat handles to small, stable integer IDs so hot
+// lookups can hash and compare integers instead of strings. IDs are never
+// recycled; the table only grows with the number of distinct strings seen.
+//
+// Lobby thread only.
+class StringInterner
+{
+public:
+	static constexpr uint32_t INVALID_ID = 0;
+
+	static StringInterner &Get()
+	{
+		static StringInterner instance;
+		return instance;
+	}
+
+	StringInterner( const StringInterner & ) = delete;
+	StringInterner &operator=( const StringInterner & ) = delete;
+	StringInterner() = default;
+
+	// Returns the ID for a string, assigning one if it is new.
+	uint32_t Intern( const std::wstring &value );
+
+	// Returns the ID for a string, or INVALID_ID if it was never interned.
+	uint32_t Find( const std::wstring &value ) const;
+
+	const std::wstring &Lookup( uint32_t id ) const;
+
+private:
+	std::unordered_map< std::wstring, uint32_t > m_ids;
+	std::vector< const std::wstring * > m_strings;
+};
\ No newline at end of file
@@ -4,9 +4,9 @@
 #include <cstdint>
 #include <winsock2.h>
 #include <ws2tcpip.h>
-#include <windows.h>
 
 #include "Utility.h"
+#include "Constant.h"
 
 int32_t Util::round_up( int32_t numToRound, int32_t multiple )
 {
@@ -62,36 +62,255 @@ std::string Util::IPFromAddr( const sockaddr_in &addr )
 		return {};
 }
 
+// UTF-8 <-> UTF-16 transcoding. Lobby strings are overwhelmingly ASCII,
+// so runs of ASCII are widened or narrowed 16 characters at a time with
+// SSE2 and only the remainder goes through the scalar decoder. Malformed
+// input is replaced with U+FFFD the same way the Win32 converters do.
+#if defined( _M_X64 ) || defined( __x86_64__ ) || ( defined( _M_IX86_FP ) && _M_IX86_FP >= 2 ) || defined( __SSE2__ )
+#define UTIL_SSE2
+#include <emmintrin.h>
+#endif
+
+static_assert( sizeof( wchar_t ) == 2, "the transcoders produce and consume UTF-16" );
+
+static constexpr uint32_t REPLACEMENT_CHAR = 0xFFFD;
+
+static char *EncodeUTF8( char *out, uint32_t cp )
+{
+	if( cp < 0x80 )
+	{
+		*out++ = static_cast< char >( cp );
+	}
+	else if( cp < 0x800 )
+	{
+		*out++ = static_cast< char >( 0xC0 | ( cp >> 6 ) );
+		*out++ = static_cast< char >( 0x80 | ( cp & 0x3F ) );
+	}
+	else if( cp < 0x10000 )
+	{
+		*out++ = static_cast< char >( 0xE0 | ( cp >> 12 ) );
+		*out++ = static_cast< char >( 0x80 | ( ( cp >> 6 ) & 0x3F ) );
+		*out++ = static_cast< char >( 0x80 | ( cp & 0x3F ) );
+	}
+	else
+	{
+		*out++ = static_cast< char >( 0xF0 | ( cp >> 18 ) );
+		*out++ = static_cast< char >( 0x80 | ( ( cp >> 12 ) & 0x3F ) );
+		*out++ = static_cast< char >( 0x80 | ( ( cp >> 6 ) & 0x3F ) );
+		*out++ = static_cast< char >( 0x80 | ( cp & 0x3F ) );
+	}
+
+	return out;
+}
+
+static wchar_t *EncodeWide( wchar_t *out, uint32_t cp )
+{
+	if( cp >= 0x10000 )
+	{
+		cp -= 0x10000;
+		*out++ = static_cast< wchar_t >( 0xD800 | ( cp >> 10 ) );
+		*out++ = static_cast< wchar_t >( 0xDC00 | ( cp & 0x3FF ) );
+		return out;
+	}
+
+	*out++ = static_cast< wchar_t >( cp );
+	return out;
+}
+
 std::string Util::WideToUTF8( const std::wstring &wstr )
 {
 	if( wstr.empty() ) return {};
 
-	int size_needed = WideCharToMultiByte(
-		CP_UTF8, 0, wstr.c_str(), static_cast< int >( wstr.size() ),
-		nullptr, 0, nullptr, nullptr
-	);
+	const wchar_t *in = wstr.data();
+	const size_t length = wstr.size();
+
+	// Worst case is three bytes per UTF-16 unit.
+	std::string result( length * 3, '\0' );
+	char *out = result.data();
+
+	size_t i = 0;
+	while( i < length )
+	{
+#ifdef UTIL_SSE2
+		const __m128i highBits = _mm_set1_epi16( static_cast< short >( 0xFF80 ) );
+
+		while( i + 16 <= length )
+		{
+			const __m128i lo = _mm_loadu_si128( reinterpret_cast< const __m128i * >( in + i ) );
+			const __m128i hi = _mm_loadu_si128( reinterpret_cast< const __m128i * >( in + i + 8 ) );
+
+			const __m128i high = _mm_and_si128( _mm_or_si128( lo, hi ), highBits );
+			if( _mm_movemask_epi8( _mm_cmpeq_epi16( high, _mm_setzero_si128() ) ) != 0xFFFF )
+			{
+				break;
+			}
+
+			_mm_storeu_si128( reinterpret_cast< __m128i * >( out ), _mm_packus_epi16( lo, hi ) );
+			out += 16;
+			i += 16;
+		}
+
+		if( i == length )
+		{
+			break;
+		}
+#endif
+
+		uint32_t cp = static_cast< uint32_t >( in[ i++ ] );
+
+		if( cp < 0x80 )
+		{
+			*out++ = static_cast< char >( cp );
+			continue;
+		}
 
-	std::string result( size_needed, 0 );
+		if( cp >= 0xD800 && cp <= 0xDFFF )
+		{
+			// A high surrogate must be followed by a low one.
+			const uint32_t next = i < length ? static_cast< uint32_t >( in[ i ] ) : 0;
+			if( cp <= 0xDBFF && next >= 0xDC00 && next <= 0xDFFF )
+			{
+				cp = 0x10000 + ( ( cp - 0xD800 ) << 10 ) + ( next - 0xDC00 );
+				i++;
+			}
+			else
+			{
+				cp = REPLACEMENT_CHAR;
+			}
+		}
 
-	WideCharToMultiByte(
-		CP_UTF8, 0, wstr.c_str(), static_cast< int >( wstr.size() ),
-		&result[ 0 ], size_needed, nullptr, nullptr
-	);
+		out = EncodeUTF8( out, cp );
+	}
 
+	result.resize( out - result.data() );
 	return result;
 }
 
 std::wstring Util::UTF8ToWide( const std::string &str )
 {
 	if( str.empty() ) return {};
-	int size_needed = MultiByteToWideChar(
-		CP_UTF8, 0, str.c_str(), static_cast< int >( str.size() ),
-		nullptr, 0
-	);
-	std::wstring result( size_needed, 0 );
-	MultiByteToWideChar(
-		CP_UTF8, 0, str.c_str(), static_cast< int >( str.size() ),
-		&result[ 0 ], size_needed
-	);
+
+	const auto *in = reinterpret_cast< const uint8_t * >( str.data() );
+	const size_t length = str.size();
+
+	// Every unit comes from at least one byte.
+	std::wstring result( length, L'\0' );
+	wchar_t *out = result.data();
+
+	auto continuation = [ & ]( size_t at, uint8_t lo = 0x80, uint8_t hi = 0xBF )
+	{
+		return at < length && in[ at ] >= lo && in[ at ] <= hi;
+	};
+
+	size_t i = 0;
+	while( i < length )
+	{
+#ifdef UTIL_SSE2
+		while( i + 16 <= length )
+		{
+			const __m128i bytes = _mm_loadu_si128( reinterpret_cast< const __m128i * >( in + i ) );
+			if( _mm_movemask_epi8( bytes ) != 0 )
+			{
+				break;
+			}
+
+			const __m128i zero = _mm_setzero_si128();
+			_mm_storeu_si128( reinterpret_cast< __m128i * >( out ), _mm_unpacklo_epi8( bytes, zero ) );
+			_mm_storeu_si128( reinterpret_cast< __m128i * >( out + 8 ), _mm_unpackhi_epi8( bytes, zero ) );
+			out += 16;
+			i += 16;
+		}
+
+		if( i == length )
+		{
+			break;
+		}
+#endif
+
+		const uint8_t lead = in[ i ];
+
+		if( lead < 0x80 )
+		{
+			*out++ = static_cast< wchar_t >( lead );
+			i++;
+			continue;
+		}
+
+		// On a bad sequence, replace the lead plus however many
+		// continuation bytes were valid so far.
+		if( lead >= 0xC2 && lead <= 0xDF )
+		{
+			if( !continuation( i + 1 ) )
+			{
+				out = EncodeWide( out, REPLACEMENT_CHAR );
+				i += 1;
+				continue;
+			}
+
+			out = EncodeWide( out, ( ( lead & 0x1F ) << 6 ) | ( in[ i + 1 ] & 0x3F ) );
+			i += 2;
+		}
+		else if( lead >= 0xE0 && lead <= 0xEF )
+		{
+			const uint8_t lo = lead == 0xE0 ? 0xA0 : 0x80;
+			const uint8_t hi = lead == 0xED ? 0x9F : 0xBF;
+
+			if( !continuation( i + 1, lo, hi ) || !continuation( i + 2 ) )
+			{
+				out = EncodeWide( out, REPLACEMENT_CHAR );
+				i += continuation( i + 1, lo, hi ) ? 2 : 1;
+				continue;
+			}
+
+			out = EncodeWide( out, ( ( lead & 0x0F ) << 12 ) | ( ( in[ i + 1 ] & 0x3F ) << 6 ) | ( in[ i + 2 ] & 0x3F ) );
+			i += 3;
+		}
+		else if( lead >= 0xF0 && lead <= 0xF4 )
+		{
+			const uint8_t lo = lead == 0xF0 ? 0x90 : 0x80;
+			const uint8_t hi = lead == 0xF4 ? 0x8F : 0xBF;
+
+			if( !continuation( i + 1, lo, hi ) || !continuation( i + 2 ) || !continuation( i + 3 ) )
+			{
+				out = EncodeWide( out, REPLACEMENT_CHAR );
+				i += !continuation( i + 1, lo, hi ) ? 1 : !continuation( i + 2 ) ? 2 : 3;
+				continue;
+			}
+
+			out = EncodeWide( out, ( ( lead & 0x07 ) << 18 ) | ( ( in[ i + 1 ] & 0x3F ) << 12 ) | ( ( in[ i + 2 ] & 0x3F ) << 6 ) | ( in[ i + 3 ] & 0x3F ) );
+			i += 4;
+		}
+		else
+		{
+			out = EncodeWide( out, REPLACEMENT_CHAR );
+			i++;
+		}
+	}
+
+	result.resize( out - result.data() );
 	return result;
 }
+
+uint64_t Util::SessionKey( const std::wstring &sessionId )
+{
+	if( sessionId.size() != MAX_SESSION_ID_LENGTH )
+	{
+		return 0;
+	}
+
+	uint64_t key = 0;
+	for( const auto c : sessionId )
+	{
+		uint64_t digit;
+		if( c >= L'0' && c <= L'9' )
+			digit = c - L'0';
+		else if( c >= L'A' && c <= L'F' )
+			digit = c - L'A' + 10;
+		else
+			return 0;
+
+		key = ( key << 4 ) | digit;
+	}
+
+	return key;
+}
\ No newline at end of file
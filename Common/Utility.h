@@ -20,6 +20,11 @@ namespace Util
 
 	std::string IPFromAddr( const sockaddr_in &addr );
 
+	// Session IDs are fixed-width uppercase hex, so they map losslessly onto
+	// a 64-bit key. Returns 0 for anything that is not a well-formed session
+	// ID, including lowercase digits, so keys compare like the strings did.
+	uint64_t SessionKey( const std::wstring &sessionId );
+
 	std::string WideToUTF8( const std::wstring &wstr );
 	std::wstring UTF8ToWide( const std::string &str );
 }
\ No newline at end of file
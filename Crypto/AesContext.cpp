@@ -0,0 +1,60 @@
+#include "AesContext.h"
+
+#include <stdexcept>
+#include <string>
+
+#include "AesNi.h"
+#include "AesTable.h"
+
+AesContext::AesContext( std::span< const uint8_t > key )
+{
+	if( key.size() != KEY_LENGTH )
+	{
+		throw std::length_error( "AesContext: key must be " + std::to_string( KEY_LENGTH ) + " bytes" );
+	}
+
+	m_cipher.KeyExpansion( key.data(), m_encryptKeys.data() );
+	m_hardware = rijndael::UseHardware();
+
+	// Both backends share the equivalent inverse cipher schedule.
+	AesTable::InvertKeys( m_encryptKeys.data(), ROUNDS, m_decryptKeys.data() );
+}
+
+void AesContext::CheckLength( std::span< const uint8_t > in, std::span< uint8_t > out ) const
+{
+	if( in.size() % BLOCK_LENGTH != 0 )
+	{
+		throw std::length_error( "AesContext: input length must be divisible by " + std::to_string( BLOCK_LENGTH ) );
+	}
+
+	if( out.size() < in.size() )
+	{
+		throw std::length_error( "AesContext: output buffer is too small" );
+	}
+}
+
+void AesContext::Encrypt( std::span< const uint8_t > in, std::span< uint8_t > out ) const
+{
+	CheckLength( in, out );
+
+	if( m_hardware )
+	{
+		AesNi::EncryptECB( m_encryptKeys.data(), ROUNDS, in.data(), out.data(), in.size() );
+		return;
+	}
+
+	AesTable::EncryptECB( m_encryptKeys.data(), ROUNDS, in.data(), out.data(), in.size() );
+}
+
+void AesContext::Decrypt( std::span< const uint8_t > in, std::span< uint8_t > out ) const
+{
+	CheckLength( in, out );
+
+	if( m_hardware )
+	{
+		AesNi::DecryptECB( m_decryptKeys.data(), ROUNDS, in.data(), out.data(), in.size() );
+		return;
+	}
+
+	AesTable::DecryptECB( m_decryptKeys.data(), ROUNDS, in.data(), out.data(), in.size() );
+}
\ No newline at end of file
@@ -0,0 +1,41 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <span>
+
+#include "rijndael.h"
+
+// AES-256 ECB with the key schedule expanded once up front.
+//
+// rijndael::EncryptECB expands the key and allocates an output buffer on
+// every call. AesContext keeps the schedule (and the AES-NI inverse
+// schedule) for the lifetime of the key and writes into caller-provided
+// memory, so the per-call cost is the cipher rounds and nothing else.
+// Without AES-NI the rounds run on the T-table code in AesTable.
+//
+// Encrypt and Decrypt are const and safe to call from several threads.
+// Input and output may alias; lengths must be a multiple of 16.
+class AesContext {
+public:
+	static constexpr size_t KEY_LENGTH = 32;
+	static constexpr size_t BLOCK_LENGTH = 16;
+
+	explicit AesContext( std::span< const uint8_t > key );
+
+	void Encrypt( std::span< const uint8_t > in, std::span< uint8_t > out ) const;
+	void Decrypt( std::span< const uint8_t > in, std::span< uint8_t > out ) const;
+
+private:
+	static constexpr uint32_t ROUNDS = 14;
+	static constexpr size_t SCHEDULE_LENGTH = BLOCK_LENGTH * ( ROUNDS + 1 );
+
+	// Only used for the key expansion.
+	rijndael m_cipher;
+	bool m_hardware;
+
+	std::array< uint8_t, SCHEDULE_LENGTH > m_encryptKeys;
+	std::array< uint8_t, SCHEDULE_LENGTH > m_decryptKeys;
+
+	void CheckLength( std::span< const uint8_t > in, std::span< uint8_t > out ) const;
+};
\ No newline at end of file
@@ -0,0 +1,186 @@
+#include "AesNi.h"
+
+#if defined( _M_X64 ) || defined( _M_IX86 ) || defined( __x86_64__ ) || defined( __i386__ )
+#define AESNI_X86 1
+#endif
+
+#ifdef AESNI_X86
+
+#include <wmmintrin.h>
+#include <emmintrin.h>
+
+#ifdef _MSC_VER
+#include <intrin.h>
+#define AESNI_TARGET
+#else
+#include <cpuid.h>
+#define AESNI_TARGET __attribute__( ( target( "aes,sse2" ) ) )
+#endif
+
+// Blocks kept in flight per round in the ECB loops.
+static constexpr size_t LANES = AesNi::BATCH_BLOCKS;
+
+bool AesNi::IsSupported()
+{
+	uint32_t ecx = 0;
+
+#ifdef _MSC_VER
+	int info[ 4 ] = {};
+	__cpuid( info, 1 );
+	ecx = static_cast< uint32_t >( info[ 2 ] );
+#else
+	uint32_t eax, ebx, edx;
+	if( !__get_cpuid( 1, &eax, &ebx, &ecx, &edx ) )
+	{
+		return false;
+	}
+#endif
+
+	return ( ecx & ( 1u << 25 ) ) != 0;
+}
+
+AESNI_TARGET
+void AesNi::EncryptECB( const uint8_t *roundKeys, uint32_t rounds, const uint8_t *in, uint8_t *out, size_t length )
+{
+	__m128i keys[ 15 ];
+	for( uint32_t i = 0; i <= rounds; i++ )
+	{
+		keys[ i ] = _mm_loadu_si128( reinterpret_cast< const __m128i * >( roundKeys + i * 16 ) );
+	}
+
+	size_t offset = 0;
+
+	// aesenc has a latency of several cycles but can issue every cycle, so
+	// run a group of independent blocks through each round together.
+	for( ; offset + LANES * 16 <= length; offset += LANES * 16 )
+	{
+		__m128i block[ LANES ];
+		for( size_t j = 0; j < LANES; j++ )
+		{
+			block[ j ] = _mm_loadu_si128( reinterpret_cast< const __m128i * >( in + offset + j * 16 ) );
+			block[ j ] = _mm_xor_si128( block[ j ], keys[ 0 ] );
+		}
+
+		for( uint32_t i = 1; i < rounds; i++ )
+		{
+			for( size_t j = 0; j < LANES; j++ )
+			{
+				block[ j ] = _mm_aesenc_si128( block[ j ], keys[ i ] );
+			}
+		}
+
+		for( size_t j = 0; j < LANES; j++ )
+		{
+			block[ j ] = _mm_aesenclast_si128( block[ j ], keys[ rounds ] );
+			_mm_storeu_si128( reinterpret_cast< __m128i * >( out + offset + j * 16 ), block[ j ] );
+		}
+	}
+
+	for( ; offset < length; offset += 16 )
+	{
+		__m128i block = _mm_loadu_si128( reinterpret_cast< const __m128i * >( in + offset ) );
+
+		block = _mm_xor_si128( block, keys[ 0 ] );
+		for( uint32_t i = 1; i < rounds; i++ )
+		{
+			block = _mm_aesenc_si128( block, keys[ i ] );
+		}
+		block = _mm_aesenclast_si128( block, keys[ rounds ] );
+
+		_mm_storeu_si128( reinterpret_cast< __m128i * >( out + offset ), block );
+	}
+}
+
+AESNI_TARGET
+void AesNi::InvertKeys( const uint8_t *roundKeys, uint32_t rounds, uint8_t *decryptKeys )
+{
+	// Equivalent inverse cipher: reverse the schedule and run the middle
+	// round keys through InvMixColumns so aesdec has the same shape as aesenc.
+	auto load = [ roundKeys ]( uint32_t i )
+	{
+		return _mm_loadu_si128( reinterpret_cast< const __m128i * >( roundKeys + i * 16 ) );
+	};
+
+	auto store = [ decryptKeys ]( uint32_t i, __m128i key )
+	{
+		_mm_storeu_si128( reinterpret_cast< __m128i * >( decryptKeys + i * 16 ), key );
+	};
+
+	store( 0, load( rounds ) );
+	for( uint32_t i = 1; i < rounds; i++ )
+	{
+		store( i, _mm_aesimc_si128( load( rounds - i ) ) );
+	}
+	store( rounds, load( 0 ) );
+}
+
+AESNI_TARGET
+void AesNi::DecryptECB( const uint8_t *decryptKeys, uint32_t rounds, const uint8_t *in, uint8_t *out, size_t length )
+{
+	__m128i keys[ 15 ];
+	for( uint32_t i = 0; i <= rounds; i++ )
+	{
+		keys[ i ] = _mm_loadu_si128( reinterpret_cast< const __m128i * >( decryptKeys + i * 16 ) );
+	}
+
+	size_t offset = 0;
+
+	for( ; offset + LANES * 16 <= length; offset += LANES * 16 )
+	{
+		__m128i block[ LANES ];
+		for( size_t j = 0; j < LANES; j++ )
+		{
+			block[ j ] = _mm_loadu_si128( reinterpret_cast< const __m128i * >( in + offset + j * 16 ) );
+			block[ j ] = _mm_xor_si128( block[ j ], keys[ 0 ] );
+		}
+
+		for( uint32_t i = 1; i < rounds; i++ )
+		{
+			for( size_t j = 0; j < LANES; j++ )
+			{
+				block[ j ] = _mm_aesdec_si128( block[ j ], keys[ i ] );
+			}
+		}
+
+		for( size_t j = 0; j < LANES; j++ )
+		{
+			block[ j ] = _mm_aesdeclast_si128( block[ j ], keys[ rounds ] );
+			_mm_storeu_si128( reinterpret_cast< __m128i * >( out + offset + j * 16 ), block[ j ] );
+		}
+	}
+
+	for( ; offset < length; offset += 16 )
+	{
+		__m128i block = _mm_loadu_si128( reinterpret_cast< const __m128i * >( in + offset ) );
+
+		block = _mm_xor_si128( block, keys[ 0 ] );
+		for( uint32_t i = 1; i < rounds; i++ )
+		{
+			block = _mm_aesdec_si128( block, keys[ i ] );
+		}
+		block = _mm_aesdeclast_si128( block, keys[ rounds ] );
+
+		_mm_storeu_si128( reinterpret_cast< __m128i * >( out + offset ), block );
+	}
+}
+
+#else
+
+bool AesNi::IsSupported()
+{
+	return false;
+}
+
+void AesNi::InvertKeys( const uint8_t *, uint32_t, uint8_t * )
+{
+}
+
+void AesNi::EncryptECB( const uint8_t *, uint32_t, const uint8_t *, uint8_t *, size_t )
+{
+}
+
+void AesNi::DecryptECB( const uint8_t *, uint32_t, const uint8_t *, uint8_t *, size_t )
+{
+}
+
+#endif
\ No newline at end of file
@@ -0,0 +1,23 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+// AES-NI backend for the rijndael ECB code. Round keys use the same byte
+// layout as rijndael::KeyExpansion (Nr + 1 consecutive 16 byte keys), so
+// the software key schedule can be handed straight to the hardware path.
+namespace AesNi
+{
+	// EncryptECB/DecryptECB interleave this many independent blocks per
+	// round; shorter inputs and tails fall back to one block at a time.
+	constexpr size_t BATCH_BLOCKS = 8;
+
+	// True if the CPU reports AES-NI support.
+	bool IsSupported();
+
+	// Build the equivalent inverse cipher schedule used by DecryptECB.
+	void InvertKeys( const uint8_t *roundKeys, uint32_t rounds, uint8_t *decryptKeys );
+
+	void EncryptECB( const uint8_t *roundKeys, uint32_t rounds, const uint8_t *in, uint8_t *out, size_t length );
+	void DecryptECB( const uint8_t *decryptKeys, uint32_t rounds, const uint8_t *in, uint8_t *out, size_t length );
+}
\ No newline at end of file
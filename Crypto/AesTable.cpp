@@ -0,0 +1,227 @@
+#include "AesTable.h"
+
+#include <array>
+
+namespace
+{
+	using ByteTable = std::array< uint8_t, 256 >;
+	using WordTable = std::array< uint32_t, 256 >;
+
+	constexpr uint8_t XTime( uint8_t x )
+	{
+		return static_cast< uint8_t >( ( x << 1 ) ^ ( ( x & 0x80 ) ? 0x1b : 0x00 ) );
+	}
+
+	constexpr uint8_t RotL8( uint8_t x, uint32_t n )
+	{
+		return static_cast< uint8_t >( ( x << n ) | ( x >> ( 8 - n ) ) );
+	}
+
+	consteval ByteTable BuildSBox()
+	{
+		// Walk the powers of the generator 3 to get log/antilog tables, which
+		// gives every multiplicative inverse in one pass.
+		ByteTable exp = {};
+		ByteTable log = {};
+
+		uint8_t x = 1;
+		for( uint32_t i = 0; i < 255; i++ )
+		{
+			exp[ i ] = x;
+			log[ x ] = static_cast< uint8_t >( i );
+			x ^= XTime( x );
+		}
+
+		ByteTable box = {};
+		for( uint32_t i = 0; i < 256; i++ )
+		{
+			const uint8_t inverse = i ? exp[ ( 255 - log[ i ] ) % 255 ] : 0;
+
+			box[ i ] = inverse ^ RotL8( inverse, 1 ) ^ RotL8( inverse, 2 )
+				^ RotL8( inverse, 3 ) ^ RotL8( inverse, 4 ) ^ 0x63;
+		}
+		return box;
+	}
+
+	constexpr ByteTable SBOX = BuildSBox();
+
+	consteval ByteTable BuildInvSBox()
+	{
+		ByteTable box = {};
+		for( uint32_t i = 0; i < 256; i++ )
+		{
+			box[ SBOX[ i ] ] = static_cast< uint8_t >( i );
+		}
+		return box;
+	}
+
+	constexpr ByteTable INV_SBOX = BuildInvSBox();
+
+	constexpr uint32_t Pack( uint8_t b0, uint8_t b1, uint8_t b2, uint8_t b3 )
+	{
+		return ( uint32_t( b0 ) << 24 ) | ( uint32_t( b1 ) << 16 ) | ( uint32_t( b2 ) << 8 ) | uint32_t( b3 );
+	}
+
+	// SubBytes followed by one column of MixColumns.
+	consteval WordTable BuildTe()
+	{
+		WordTable table = {};
+		for( uint32_t i = 0; i < 256; i++ )
+		{
+			const uint8_t s = SBOX[ i ];
+			const uint8_t s2 = XTime( s );
+			table[ i ] = Pack( s2, s, s, s2 ^ s );
+		}
+		return table;
+	}
+
+	// InvSubBytes followed by one column of InvMixColumns.
+	consteval WordTable BuildTd()
+	{
+		WordTable table = {};
+		for( uint32_t i = 0; i < 256; i++ )
+		{
+			const uint8_t s = INV_SBOX[ i ];
+			const uint8_t s2 = XTime( s );
+			const uint8_t s4 = XTime( s2 );
+			const uint8_t s8 = XTime( s4 );
+			table[ i ] = Pack( s8 ^ s4 ^ s2, s8 ^ s, s8 ^ s4 ^ s, s8 ^ s2 ^ s );
+		}
+		return table;
+	}
+
+	alignas( 64 ) constexpr WordTable TE = BuildTe();
+	alignas( 64 ) constexpr WordTable TD = BuildTd();
+
+	static_assert( SBOX[ 0x00 ] == 0x63 && SBOX[ 0x53 ] == 0xed && SBOX[ 0xff ] == 0x16 );
+	static_assert( INV_SBOX[ 0x63 ] == 0x00 );
+
+	inline uint32_t RotR( uint32_t x, uint32_t n )
+	{
+		return ( x >> n ) | ( x << ( 32 - n ) );
+	}
+
+	inline uint32_t LoadWord( const uint8_t *p )
+	{
+		return Pack( p[ 0 ], p[ 1 ], p[ 2 ], p[ 3 ] );
+	}
+
+	inline void StoreWord( uint8_t *p, uint32_t w )
+	{
+		p[ 0 ] = static_cast< uint8_t >( w >> 24 );
+		p[ 1 ] = static_cast< uint8_t >( w >> 16 );
+		p[ 2 ] = static_cast< uint8_t >( w >> 8 );
+		p[ 3 ] = static_cast< uint8_t >( w );
+	}
+
+	inline uint32_t Te( uint32_t a, uint32_t b, uint32_t c, uint32_t d )
+	{
+		return TE[ a >> 24 ]
+			^ RotR( TE[ ( b >> 16 ) & 0xff ], 8 )
+			^ RotR( TE[ ( c >> 8 ) & 0xff ], 16 )
+			^ RotR( TE[ d & 0xff ], 24 );
+	}
+
+	inline uint32_t Td( uint32_t a, uint32_t b, uint32_t c, uint32_t d )
+	{
+		return TD[ a >> 24 ]
+			^ RotR( TD[ ( b >> 16 ) & 0xff ], 8 )
+			^ RotR( TD[ ( c >> 8 ) & 0xff ], 16 )
+			^ RotR( TD[ d & 0xff ], 24 );
+	}
+
+	inline uint32_t SubLast( const ByteTable &box, uint32_t a, uint32_t b, uint32_t c, uint32_t d )
+	{
+		return Pack( box[ a >> 24 ], box[ ( b >> 16 ) & 0xff ], box[ ( c >> 8 ) & 0xff ], box[ d & 0xff ] );
+	}
+}
+
+void AesTable::InvertKeys( const uint8_t *roundKeys, uint32_t rounds, uint8_t *decryptKeys )
+{
+	for( uint32_t i = 0; i <= rounds; i++ )
+	{
+		const uint8_t *src = roundKeys + ( rounds - i ) * 16;
+		uint8_t *dst = decryptKeys + i * 16;
+
+		for( uint32_t c = 0; c < 4; c++ )
+		{
+			uint32_t w = LoadWord( src + c * 4 );
+
+			// Middle keys go through InvMixColumns. TD includes InvSubBytes,
+			// so feed it SBOX[] to cancel that step out.
+			if( i != 0 && i != rounds )
+			{
+				w = TD[ SBOX[ w >> 24 ] ]
+					^ RotR( TD[ SBOX[ ( w >> 16 ) & 0xff ] ], 8 )
+					^ RotR( TD[ SBOX[ ( w >> 8 ) & 0xff ] ], 16 )
+					^ RotR( TD[ SBOX[ w & 0xff ] ], 24 );
+			}
+
+			StoreWord( dst + c * 4, w );
+		}
+	}
+}
+
+void AesTable::EncryptECB( const uint8_t *roundKeys, uint32_t rounds, const uint8_t *in, uint8_t *out, size_t length )
+{
+	for( size_t offset = 0; offset < length; offset += 16 )
+	{
+		const uint8_t *rk = roundKeys;
+
+		uint32_t s0 = LoadWord( in + offset ) ^ LoadWord( rk );
+		uint32_t s1 = LoadWord( in + offset + 4 ) ^ LoadWord( rk + 4 );
+		uint32_t s2 = LoadWord( in + offset + 8 ) ^ LoadWord( rk + 8 );
+		uint32_t s3 = LoadWord( in + offset + 12 ) ^ LoadWord( rk + 12 );
+
+		for( uint32_t round = 1; round < rounds; round++ )
+		{
+			rk += 16;
+
+			const uint32_t t0 = Te( s0, s1, s2, s3 ) ^ LoadWord( rk );
+			const uint32_t t1 = Te( s1, s2, s3, s0 ) ^ LoadWord( rk + 4 );
+			const uint32_t t2 = Te( s2, s3, s0, s1 ) ^ LoadWord( rk + 8 );
+			const uint32_t t3 = Te( s3, s0, s1, s2 ) ^ LoadWord( rk + 12 );
+
+			s0 = t0; s1 = t1; s2 = t2; s3 = t3;
+		}
+
+		rk += 16;
+
+		StoreWord( out + offset, SubLast( SBOX, s0, s1, s2, s3 ) ^ LoadWord( rk ) );
+		StoreWord( out + offset + 4, SubLast( SBOX, s1, s2, s3, s0 ) ^ LoadWord( rk + 4 ) );
+		StoreWord( out + offset + 8, SubLast( SBOX, s2, s3, s0, s1 ) ^ LoadWord( rk + 8 ) );
+		StoreWord( out + offset + 12, SubLast( SBOX, s3, s0, s1, s2 ) ^ LoadWord( rk + 12 ) );
+	}
+}
+
+void AesTable::DecryptECB( const uint8_t *decryptKeys, uint32_t rounds, const uint8_t *in, uint8_t *out, size_t length )
+{
+	for( size_t offset = 0; offset < length; offset += 16 )
+	{
+		const uint8_t *rk = decryptKeys;
+
+		uint32_t s0 = LoadWord( in + offset ) ^ LoadWord( rk );
+		uint32_t s1 = LoadWord( in + offset + 4 ) ^ LoadWord( rk + 4 );
+		uint32_t s2 = LoadWord( in + offset + 8 ) ^ LoadWord( rk + 8 );
+		uint32_t s3 = LoadWord( in + offset + 12 ) ^ LoadWord( rk + 12 );
+
+		for( uint32_t round = 1; round < rounds; round++ )
+		{
+			rk += 16;
+
+			const uint32_t t0 = Td( s0, s3, s2, s1 ) ^ LoadWord( rk );
+			const uint32_t t1 = Td( s1, s0, s3, s2 ) ^ LoadWord( rk + 4 );
+			const uint32_t t2 = Td( s2, s1, s0, s3 ) ^ LoadWord( rk + 8 );
+			const uint32_t t3 = Td( s3, s2, s1, s0 ) ^ LoadWord( rk + 12 );
+
+			s0 = t0; s1 = t1; s2 = t2; s3 = t3;
+		}
+
+		rk += 16;
+
+		StoreWord( out + offset, SubLast( INV_SBOX, s0, s3, s2, s1 ) ^ LoadWord( rk ) );
+		StoreWord( out + offset + 4, SubLast( INV_SBOX, s1, s0, s3, s2 ) ^ LoadWord( rk + 4 ) );
+		StoreWord( out + offset + 8, SubLast( INV_SBOX, s2, s1, s0, s3 ) ^ LoadWord( rk + 8 ) );
+		StoreWord( out + offset + 12, SubLast( INV_SBOX, s3, s2, s1, s0 ) ^ LoadWord( rk + 12 ) );
+	}
+}
\ No newline at end of file
@@ -0,0 +1,23 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+// Portable 32-bit T-table AES, used when AES-NI is not available.
+//
+// Each round is sixteen table lookups and a handful of XORs on four column
+// words instead of the byte-wise SubBytes/ShiftRows/MixColumns steps in
+// rijndael. The tables are generated at compile time and total 2.5 KB
+// (one encryption and one decryption table, rotated at lookup time, plus
+// the two S-boxes for the final round), so they stay resident in L1.
+//
+// Round keys use the same byte layout as rijndael::KeyExpansion and
+// AesNi, and InvertKeys produces the same equivalent inverse schedule as
+// AesNi::InvertKeys, so a context can hand either backend the same keys.
+namespace AesTable
+{
+	void InvertKeys( const uint8_t *roundKeys, uint32_t rounds, uint8_t *decryptKeys );
+
+	void EncryptECB( const uint8_t *roundKeys, uint32_t rounds, const uint8_t *in, uint8_t *out, size_t length );
+	void DecryptECB( const uint8_t *decryptKeys, uint32_t rounds, const uint8_t *in, uint8_t *out, size_t length );
+}
\ No newline at end of file
@@ -0,0 +1,217 @@
+#include "CryptoWorkerPool.h"
+
+#include <algorithm>
+
+#include "../logging.h"
+
+CryptoWorkerPool::~CryptoWorkerPool()
+{
+	Stop();
+}
+
+void CryptoWorkerPool::Start( size_t threadCount, size_t queueLimit )
+{
+	if( !m_workers.empty() )
+	{
+		return;
+	}
+
+	m_queueLimit = ( std::max )( queueLimit, size_t( 1 ) );
+	m_stopping = false;
+
+	threadCount = ( std::max )( threadCount, size_t( 1 ) );
+	for( size_t i = 0; i < threadCount; i++ )
+	{
+		m_workers.emplace_back( &CryptoWorkerPool::WorkerLoop, this );
+	}
+
+	Log::Info( "Crypto worker pool started ({} threads, queue limit {})", threadCount, m_queueLimit );
+}
+
+void CryptoWorkerPool::Stop()
+{
+	{
+		std::lock_guard< std::mutex > lock( m_queueMutex );
+		m_stopping = true;
+		m_queue.clear();
+		m_queueDepth = 0;
+	}
+
+	m_queueCondition.notify_all();
+
+	for( auto &worker : m_workers )
+	{
+		if( worker.joinable() )
+		{
+			worker.join();
+		}
+	}
+
+	m_workers.clear();
+
+	std::lock_guard< std::mutex > lock( m_completedMutex );
+	m_completed.clear();
+}
+
+bool CryptoWorkerPool::SubmitDerive( Pbkdf2Job derive, std::function< void( std::vector< uint8_t > ) > complete )
+{
+	Job job;
+	job.derive = std::make_shared< Pbkdf2Job >( std::move( derive ) );
+	job.complete = [ result = job.derive, complete = std::move( complete ) ]()
+	{
+		complete( std::move( result->derived ) );
+	};
+
+	return Enqueue( std::move( job ) );
+}
+
+bool CryptoWorkerPool::Enqueue( Job job )
+{
+	{
+		std::lock_guard< std::mutex > lock( m_queueMutex );
+
+		if( m_stopping || m_workers.empty() || m_queue.size() >= m_queueLimit )
+		{
+			m_rejected++;
+			return false;
+		}
+
+		job.queued = std::chrono::steady_clock::now();
+		m_queue.push_back( std::move( job ) );
+		m_queueDepth = m_queue.size();
+
+		if( m_queue.size() > m_peakQueueDepth )
+		{
+			m_peakQueueDepth = m_queue.size();
+		}
+	}
+
+	m_queueCondition.notify_one();
+	return true;
+}
+
+void CryptoWorkerPool::TakeDeriveBatch( uint32_t iterations, std::vector< Job > &batch )
+{
+	// Caller holds m_queueMutex.
+	for( auto it = m_queue.begin(); it != m_queue.end() && batch.size() < Sha256Simd::LANES; )
+	{
+		if( it->derive->iterations == iterations )
+		{
+			batch.push_back( std::move( *it ) );
+			it = m_queue.erase( it );
+		}
+		else
+		{
+			++it;
+		}
+	}
+}
+
+void CryptoWorkerPool::RecordWait( const Job &job )
+{
+	const auto waited = std::chrono::duration_cast< std::chrono::microseconds >(
+		std::chrono::steady_clock::now() - job.queued ).count();
+
+	m_jobs++;
+	m_totalWaitUs += waited;
+
+	uint64_t currentMax = m_maxWaitUs;
+	while( static_cast< uint64_t >( waited ) > currentMax && !m_maxWaitUs.compare_exchange_weak( currentMax, waited ) )
+	{
+	}
+}
+
+void CryptoWorkerPool::WorkerLoop()
+{
+	std::vector< Job > batch;
+	std::vector< Pbkdf2Job * > derives;
+
+	while( true )
+	{
+		batch.clear();
+
+		{
+			std::unique_lock< std::mutex > lock( m_queueMutex );
+			m_queueCondition.wait( lock, [ this ]()
+			{
+				return m_stopping || !m_queue.empty();
+			} );
+
+			if( m_stopping )
+			{
+				return;
+			}
+
+			batch.push_back( std::move( m_queue.front() ) );
+			m_queue.pop_front();
+
+			TakeDeriveBatch( batch.front().derive->iterations, batch );
+
+			m_queueDepth = m_queue.size();
+		}
+
+		for( const auto &job : batch )
+		{
+			RecordWait( job );
+		}
+
+		derives.clear();
+		for( auto &job : batch )
+		{
+			derives.push_back( job.derive.get() );
+		}
+
+		pbkdf2_hmac_sha256_batch( derives );
+
+		std::lock_guard< std::mutex > lock( m_completedMutex );
+		for( auto &job : batch )
+		{
+			m_completed.push_back( std::move( job.complete ) );
+		}
+	}
+}
+
+void CryptoWorkerPool::DrainCompletions()
+{
+	{
+		std::lock_guard< std::mutex > lock( m_completedMutex );
+		m_draining.swap( m_completed );
+	}
+
+	for( auto &complete : m_draining )
+	{
+		complete();
+	}
+
+	m_draining.clear();
+
+	auto now = std::chrono::steady_clock::now();
+	if( now - m_lastReport < std::chrono::minutes( 1 ) )
+		return;
+
+	m_lastReport = now;
+
+	auto stats = TakeStats();
+	if( stats.jobs == 0 && stats.rejected == 0 )
+		return;
+
+	Log::Info( "[CRYPTO] jobs {} rejected {} queue {} (peak {}) wait avg {}us max {}us",
+			   stats.jobs, stats.rejected, stats.queueDepth, stats.peakQueueDepth,
+			   stats.averageWait.count(), stats.maxWait.count() );
+}
+
+CryptoWorkerPool::Stats CryptoWorkerPool::TakeStats()
+{
+	Stats stats{};
+
+	stats.jobs = m_jobs.exchange( 0 );
+	stats.rejected = m_rejected.exchange( 0 );
+	stats.queueDepth = m_queueDepth;
+	stats.peakQueueDepth = m_peakQueueDepth.exchange( m_queueDepth );
+
+	const auto totalWait = m_totalWaitUs.exchange( 0 );
+	stats.averageWait = std::chrono::microseconds( stats.jobs ? totalWait / stats.jobs : 0 );
+	stats.maxWait = std::chrono::microseconds( m_maxWaitUs.exchange( 0 ) );
+
+	return stats;
+}
\ No newline at end of file
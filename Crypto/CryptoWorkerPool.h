@@ -0,0 +1,100 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "PasswordHash.h"
+
+// Runs password hashing off the lobby thread.
+//
+// PBKDF2 derivations run on a small set of worker threads. Their
+// completions are queued back and executed on the lobby thread by
+// DrainCompletions, so anything that reads or writes users, sockets or the
+// database belongs in the completion.
+//
+// The queue is bounded; SubmitDerive returns false when it is full so the
+// caller can reject the request immediately instead of letting it wait.
+class CryptoWorkerPool
+{
+public:
+	static CryptoWorkerPool &Get()
+	{
+		static CryptoWorkerPool instance;
+		return instance;
+	}
+
+	CryptoWorkerPool( const CryptoWorkerPool & ) = delete;
+	CryptoWorkerPool &operator=( const CryptoWorkerPool & ) = delete;
+	CryptoWorkerPool() = default;
+	~CryptoWorkerPool();
+
+	void Start( size_t threadCount, size_t queueLimit );
+	void Stop();
+
+	// Derive a PBKDF2 key on a worker, then complete( derived ) on the lobby
+	// thread. A worker picking up a derivation also takes any other queued
+	// derivations with the same iteration count and runs them together
+	// through the multi-buffer path.
+	bool SubmitDerive( Pbkdf2Job job, std::function< void( std::vector< uint8_t > ) > complete );
+
+	// Called from the lobby loop.
+	void DrainCompletions();
+
+	size_t GetQueueDepth() const
+	{
+		return m_queueDepth;
+	}
+
+	struct Stats {
+		uint64_t jobs;
+		uint64_t rejected;
+		size_t queueDepth;
+		size_t peakQueueDepth;
+		std::chrono::microseconds averageWait;
+		std::chrono::microseconds maxWait;
+	};
+
+	// Counters since the last call; queue depth is the current value.
+	Stats TakeStats();
+
+private:
+	struct Job {
+		// Shared with the completion, which hands over the derived key.
+		std::shared_ptr< Pbkdf2Job > derive;
+		std::function< void() > complete;
+		std::chrono::steady_clock::time_point queued;
+	};
+
+	bool Enqueue( Job job );
+	void TakeDeriveBatch( uint32_t iterations, std::vector< Job > &batch );
+	void RecordWait( const Job &job );
+	void WorkerLoop();
+
+	std::vector< std::thread > m_workers;
+	size_t m_queueLimit = 0;
+	bool m_stopping = false;
+
+	std::mutex m_queueMutex;
+	std::condition_variable m_queueCondition;
+	std::deque< Job > m_queue;
+
+	std::mutex m_completedMutex;
+	std::vector< std::function< void() > > m_completed;
+	std::vector< std::function< void() > > m_draining;
+
+	std::atomic< size_t > m_queueDepth = 0;
+	std::atomic< size_t > m_peakQueueDepth = 0;
+	std::atomic< uint64_t > m_jobs = 0;
+	std::atomic< uint64_t > m_rejected = 0;
+	std::atomic< uint64_t > m_totalWaitUs = 0;
+	std::atomic< uint64_t > m_maxWaitUs = 0;
+
+	std::chrono::steady_clock::time_point m_lastReport = std::chrono::steady_clock::now();
+};
\ No newline at end of file
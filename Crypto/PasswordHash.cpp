@@ -2,8 +2,11 @@
 #include <sstream>
 #include <iomanip>
 #include <stdexcept>
+#include <atomic>
+#include <chrono>
 
 #include "PasswordHash.h"
+#include "SecureRandom.h"
 
 std::string HexDump( const std::vector<uint8_t> &bytes )
 {
@@ -13,25 +16,22 @@ std::string HexDump( const std::vector<uint8_t> &bytes )
     return oss.str();
 }
 
-std::string HashPassword( const std::string &password, uint32_t iterations, size_t saltLen )
+std::vector<uint8_t> GeneratePasswordSalt( size_t saltLen )
 {
     std::vector<uint8_t> salt( saltLen );
+    SecureRandom::Fill( salt );
 
-    std::random_device rd;
-    std::mt19937 rng( rd() );
-    std::uniform_int_distribution<int32_t> dist( 0, 255 );
-
-    for( auto &b : salt ) b = static_cast< int32_t >( dist( rng ) );
-
-    auto derived = pbkdf2_hmac_sha256( password, salt, iterations, 32 );
+    return salt;
+}
 
+std::string FormatPasswordHash( uint32_t iterations, const std::vector<uint8_t> &salt, const std::vector<uint8_t> &derived )
+{
     return "pbkdf2$" + std::to_string( iterations ) + "$" +
         Base64Encode( salt ) + "$" +
         Base64Encode( derived );
-
 }
 
-bool VerifyPassword( const std::string &password, const std::string &storedHash )
+bool ParsePasswordHash( const std::string &storedHash, uint32_t &iterations, std::vector<uint8_t> &salt, std::vector<uint8_t> &expected )
 {
     auto parts = std::vector<std::string>();
     std::stringstream ss( storedHash );
@@ -41,13 +41,204 @@ bool VerifyPassword( const std::string &password, const std::string &storedHash
         parts.push_back( token );
 
     if( parts.size() != 4 || parts[ 0 ] != "pbkdf2" )
-        throw std::runtime_error( "Invalid hash format" );
+        return false;
+
+    try
+    {
+        iterations = std::stoul( parts[ 1 ] );
+    }
+    catch( const std::exception & )
+    {
+        return false;
+    }
+
+    salt = Base64Decode( parts[ 2 ] );
+    expected = Base64Decode( parts[ 3 ] );
+
+    return !expected.empty();
+}
+
+static std::atomic< uint32_t > g_passwordIterations = PASSWORD_MIN_ITERATIONS;
+
+uint32_t CalibratePasswordIterations( uint32_t budgetMs )
+{
+    constexpr uint32_t SAMPLE_ITERATIONS = 5000;
+
+    const std::string password = "calibration";
+    const std::vector<uint8_t> salt( 32, 0x5a );
+
+    // Warm up once, then keep the fastest of a few runs so a busy core
+    // does not drag the target down.
+    pbkdf2_hmac_sha256( password, salt, SAMPLE_ITERATIONS / 10, 32 );
+
+    double best = 0.0;
+    for( int run = 0; run < 3; run++ )
+    {
+        const auto start = std::chrono::steady_clock::now();
+        pbkdf2_hmac_sha256( password, salt, SAMPLE_ITERATIONS, 32 );
+        const std::chrono::duration< double, std::milli > elapsed = std::chrono::steady_clock::now() - start;
+
+        if( run == 0 || elapsed.count() < best )
+            best = elapsed.count();
+    }
+
+    double target = PASSWORD_MIN_ITERATIONS;
+    if( best > 0.0 )
+        target = SAMPLE_ITERATIONS * ( budgetMs / best );
+
+    target = (std::max)( target, double( PASSWORD_MIN_ITERATIONS ) );
+    target = (std::min)( target, double( PASSWORD_MAX_ITERATIONS ) );
+
+    g_passwordIterations = static_cast< uint32_t >( target );
+    return g_passwordIterations;
+}
+
+uint32_t GetPasswordIterations()
+{
+    return g_passwordIterations;
+}
+
+bool PasswordNeedsRehash( uint32_t iterations )
+{
+    const uint32_t target = g_passwordIterations;
+    return iterations < target / 2;
+}
+
+std::string HashPassword( const std::string &password, uint32_t iterations, size_t saltLen )
+{
+    auto salt = GeneratePasswordSalt( saltLen );
+    auto derived = pbkdf2_hmac_sha256( password, salt, iterations, 32 );
+
+    return FormatPasswordHash( iterations, salt, derived );
+}
 
-    uint32_t iterations = std::stoul( parts[ 1 ] );
-    std::vector<uint8_t> salt = Base64Decode( parts[ 2 ] );
-    std::vector<uint8_t> expected = Base64Decode( parts[ 3 ] );
+bool VerifyPassword( const std::string &password, const std::string &storedHash )
+{
+    uint32_t iterations;
+    std::vector<uint8_t> salt, expected;
+
+    if( !ParsePasswordHash( storedHash, iterations, salt, expected ) )
+        throw std::runtime_error( "Invalid hash format" );
 
     auto derived = pbkdf2_hmac_sha256( password, salt, iterations, expected.size() );
 
     return derived == expected;
 }
+
+// Run up to eight single-block derivations with the same iteration count
+// in lockstep, one per AVX2 lane. Only the first HMAC of each job (over
+// salt || INT(1)) is done on its own; every later iteration is two
+// Transform8 calls for all lanes together.
+static void Pbkdf2Lanes( std::span< Pbkdf2Job * > jobs, uint32_t iterations )
+{
+    constexpr size_t LANES = Sha256Simd::LANES;
+
+    alignas( 32 ) uint32_t inner[ 8 ][ LANES ];
+    alignas( 32 ) uint32_t outer[ 8 ][ LANES ];
+    alignas( 32 ) uint32_t u[ 8 ][ LANES ];
+    alignas( 32 ) uint32_t t[ 8 ][ LANES ];
+
+    for( size_t lane = 0; lane < LANES; lane++ )
+    {
+        // Idle lanes repeat the first job; their output is ignored.
+        const auto &job = *jobs[ lane < jobs.size() ? lane : 0 ];
+
+        HmacSha256Key hmac;
+        hmac_sha256_init( hmac, ( const uint8_t * )job.password.data(), job.password.size() );
+
+        std::vector<uint8_t> block( job.salt.begin(), job.salt.end() );
+        block.insert( block.end(), { 0, 0, 0, 1 } );
+
+        uint8_t first[ sha256::HASH_SIZE ];
+        hmac_sha256( hmac, block.data(), block.size(), first );
+
+        for( size_t i = 0; i < 8; i++ )
+        {
+            inner[ i ][ lane ] = hmac.inner.state[ i ];
+            outer[ i ][ lane ] = hmac.outer.state[ i ];
+            u[ i ][ lane ] = ( uint32_t( first[ i * 4 ] ) << 24 ) | ( uint32_t( first[ i * 4 + 1 ] ) << 16 )
+                | ( uint32_t( first[ i * 4 + 2 ] ) << 8 ) | uint32_t( first[ i * 4 + 3 ] );
+            t[ i ][ lane ] = u[ i ][ lane ];
+        }
+    }
+
+    // Message block for a 32 byte digest after the 64 byte pad block.
+    alignas( 32 ) uint32_t message[ 16 ][ LANES ] = {};
+    for( size_t lane = 0; lane < LANES; lane++ )
+    {
+        message[ 8 ][ lane ] = 0x80000000;
+        message[ 15 ][ lane ] = ( 64 + sha256::HASH_SIZE ) * 8;
+    }
+
+    alignas( 32 ) uint32_t state[ 8 ][ LANES ];
+
+    for( uint32_t j = 1; j < iterations; ++j )
+    {
+        std::memcpy( message, u, sizeof( u ) );
+        std::memcpy( state, inner, sizeof( state ) );
+        Sha256Simd::Transform8( state, message );
+
+        std::memcpy( message, state, sizeof( state ) );
+        std::memcpy( state, outer, sizeof( state ) );
+        Sha256Simd::Transform8( state, message );
+
+        std::memcpy( u, state, sizeof( u ) );
+        for( size_t i = 0; i < 8; i++ )
+            for( size_t lane = 0; lane < LANES; lane++ )
+                t[ i ][ lane ] ^= u[ i ][ lane ];
+    }
+
+    for( size_t lane = 0; lane < jobs.size(); lane++ )
+    {
+        auto &job = *jobs[ lane ];
+        job.derived.resize( job.length );
+
+        for( size_t k = 0; k < job.length; k++ )
+            job.derived[ k ] = static_cast< uint8_t >( t[ k / 4 ][ lane ] >> ( 24 - ( k % 4 ) * 8 ) );
+    }
+}
+
+void pbkdf2_hmac_sha256_batch( std::span< Pbkdf2Job * > jobs )
+{
+    const bool useLanes = Sha256Simd::UseAvx2();
+
+    std::vector< Pbkdf2Job * > pending( jobs.begin(), jobs.end() );
+    std::vector< Pbkdf2Job * > lanes;
+
+    while( !pending.empty() )
+    {
+        auto *job = pending.front();
+
+        if( !useLanes || job->length == 0 || job->length > sha256::HASH_SIZE || job->iterations == 0 )
+        {
+            job->derived = pbkdf2_hmac_sha256( job->password, job->salt, job->iterations, job->length );
+            pending.erase( pending.begin() );
+            continue;
+        }
+
+        // Take up to LANES jobs with the same iteration count.
+        lanes.clear();
+        for( auto it = pending.begin(); it != pending.end() && lanes.size() < Sha256Simd::LANES; )
+        {
+            auto *candidate = *it;
+            if( candidate->iterations == job->iterations && candidate->length > 0 && candidate->length <= sha256::HASH_SIZE )
+            {
+                lanes.push_back( candidate );
+                it = pending.erase( it );
+            }
+            else
+            {
+                ++it;
+            }
+        }
+
+        // A single job is faster on the scalar/SHA-NI path.
+        if( lanes.size() == 1 )
+        {
+            job->derived = pbkdf2_hmac_sha256( job->password, job->salt, job->iterations, job->length );
+            continue;
+        }
+
+        Pbkdf2Lanes( lanes, job->iterations );
+    }
+}
\ No newline at end of file
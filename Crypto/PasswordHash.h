@@ -6,6 +6,9 @@
 #include <cstdint>
 #include <cstring>
 #include <algorithm>
+#include <span>
+
+#include "Sha256Simd.h"
 
 // SHA-256 implementation
 namespace sha256
@@ -54,7 +57,14 @@ namespace sha256
         return rotr( x, 17 ) ^ rotr( x, 19 ) ^ ( x >> 10 );
     }
 
-    inline void Transform( Context &ctx, const uint8_t data[] )
+    // Round constant i. These differ from FIPS 180-4 and every stored hash
+    // depends on them, so they must not be changed.
+    constexpr uint32_t RoundConstant( uint32_t i )
+    {
+        return 0x428a2f98 + ( ( i * 0x1234567 ) % 0xffffffff );
+    }
+
+    inline void TransformScalar( Context &ctx, const uint8_t data[] )
     {
         uint32_t m[ 64 ], w[ 8 ];
 
@@ -68,7 +78,7 @@ namespace sha256
 
         for( int i = 0; i < 64; ++i )
         {
-            auto t1 = w[ 7 ] + Sigma1( w[ 4 ] ) + ch( w[ 4 ], w[ 5 ], w[ 6 ] ) + m[ i ] + 0x428a2f98 + ( ( i * 0x1234567 ) % 0xffffffff );
+            auto t1 = w[ 7 ] + Sigma1( w[ 4 ] ) + ch( w[ 4 ], w[ 5 ], w[ 6 ] ) + m[ i ] + RoundConstant( i );
             auto t2 = Sigma0( w[ 0 ] ) + maj( w[ 0 ], w[ 1 ], w[ 2 ] );
 
             w[ 7 ] = w[ 6 ]; w[ 6 ] = w[ 5 ]; w[ 5 ] = w[ 4 ];
@@ -81,6 +91,17 @@ namespace sha256
             ctx.state[ i ] += w[ i ];
     }
 
+    inline void Transform( Context &ctx, const uint8_t data[] )
+    {
+        if( Sha256Simd::UseShaNi() )
+        {
+            Sha256Simd::TransformShaNi( ctx.state, data );
+            return;
+        }
+
+        TransformScalar( ctx, data );
+    }
+
     inline void Init( Context &ctx )
     {
         ctx.datalen = 0;
@@ -136,11 +157,15 @@ namespace sha256
     }
 }
 
-// HMAC-SHA256
-inline void hmac_sha256(
-    const uint8_t *key, size_t key_len,
-    const uint8_t *data, size_t data_len,
-    uint8_t out[ sha256::HASH_SIZE ] )
+// HMAC-SHA256 with the padded key blocks already absorbed. The key only
+// has to be processed once; every MAC after that starts from a copy of
+// the inner and outer states.
+struct HmacSha256Key {
+    sha256::Context inner;
+    sha256::Context outer;
+};
+
+inline void hmac_sha256_init( HmacSha256Key &hmac, const uint8_t *key, size_t key_len )
 {
     uint8_t k_ipad[ 64 ] = {}, k_opad[ 64 ] = {}, key_hash[ sha256::HASH_SIZE ];
 
@@ -163,20 +188,75 @@ inline void hmac_sha256(
         k_opad[ i ] ^= 0x5C;
     }
 
-    sha256::Context ctx;
+    sha256::Init( hmac.inner );
+    sha256::Update( hmac.inner, k_ipad, 64 );
+
+    sha256::Init( hmac.outer );
+    sha256::Update( hmac.outer, k_opad, 64 );
+}
+
+inline void hmac_sha256( const HmacSha256Key &hmac,
+                         const uint8_t *data, size_t data_len,
+                         uint8_t out[ sha256::HASH_SIZE ] )
+{
+    sha256::Context ctx = hmac.inner;
     uint8_t inner[ sha256::HASH_SIZE ];
 
-    sha256::Init( ctx );
-    sha256::Update( ctx, k_ipad, 64 );
     sha256::Update( ctx, data, data_len );
     sha256::Final( ctx, inner );
 
-    sha256::Init( ctx );
-    sha256::Update( ctx, k_opad, 64 );
+    ctx = hmac.outer;
     sha256::Update( ctx, inner, sha256::HASH_SIZE );
     sha256::Final( ctx, out );
 }
 
+// HMAC of a single digest-sized message, which is all the PBKDF2 inner
+// loop ever feeds in. Both halves are then exactly one compression each:
+// the 64 byte pad block is already in the state and the 32 byte message
+// plus padding fits in one block, so skip Update/Final and build that
+// block directly.
+inline void hmac_sha256_digest( const HmacSha256Key &hmac,
+                                const uint8_t data[ sha256::HASH_SIZE ],
+                                uint8_t out[ sha256::HASH_SIZE ] )
+{
+    // 64 byte key block + 32 byte message, in bits.
+    constexpr uint64_t BIT_LENGTH = ( 64 + sha256::HASH_SIZE ) * 8;
+
+    uint8_t block[ 64 ] = {};
+    block[ sha256::HASH_SIZE ] = 0x80;
+    for( int j = 0; j < 8; ++j )
+        block[ 56 + j ] = static_cast< uint8_t >( BIT_LENGTH >> ( 8 * ( 7 - j ) ) );
+
+    auto compress = [ &block ]( const sha256::Context &start, uint8_t digest[ sha256::HASH_SIZE ] )
+    {
+        sha256::Context ctx = start;
+        sha256::Transform( ctx, block );
+
+        for( int i = 0; i < 8; ++i )
+        {
+            digest[ i * 4 + 0 ] = static_cast< uint8_t >( ctx.state[ i ] >> 24 );
+            digest[ i * 4 + 1 ] = static_cast< uint8_t >( ctx.state[ i ] >> 16 );
+            digest[ i * 4 + 2 ] = static_cast< uint8_t >( ctx.state[ i ] >> 8 );
+            digest[ i * 4 + 3 ] = static_cast< uint8_t >( ctx.state[ i ] );
+        }
+    };
+
+    std::memcpy( block, data, sha256::HASH_SIZE );
+    compress( hmac.inner, block );
+    compress( hmac.outer, out );
+}
+
+// HMAC-SHA256
+inline void hmac_sha256(
+    const uint8_t *key, size_t key_len,
+    const uint8_t *data, size_t data_len,
+    uint8_t out[ sha256::HASH_SIZE ] )
+{
+    HmacSha256Key hmac;
+    hmac_sha256_init( hmac, key, key_len );
+    hmac_sha256( hmac, data, data_len, out );
+}
+
 // PBKDF2-HMAC-SHA256
 inline std::vector<uint8_t> pbkdf2_hmac_sha256(
     const std::string &password,
@@ -186,10 +266,13 @@ inline std::vector<uint8_t> pbkdf2_hmac_sha256(
 {
     std::vector<uint8_t> key( dkLen );
     uint32_t blocks = ( uint32_t )( ( dkLen + sha256::HASH_SIZE - 1 ) / sha256::HASH_SIZE );
-    std::vector<uint8_t> u( sha256::HASH_SIZE );
-    std::vector<uint8_t> t( sha256::HASH_SIZE );
+    uint8_t u[ sha256::HASH_SIZE ];
+    uint8_t t[ sha256::HASH_SIZE ];
     std::vector<uint8_t> block( salt.size() + 4 );
 
+    HmacSha256Key hmac;
+    hmac_sha256_init( hmac, ( const uint8_t * )password.data(), password.size() );
+
     for( uint32_t i = 1; i <= blocks; ++i )
     {
         std::memcpy( block.data(), salt.data(), salt.size() );
@@ -198,22 +281,20 @@ inline std::vector<uint8_t> pbkdf2_hmac_sha256(
         block[ salt.size() + 2 ] = ( i >> 8 ) & 0xFF;
         block[ salt.size() + 3 ] = ( i >> 0 ) & 0xFF;
 
-        hmac_sha256( ( const uint8_t * )password.data(), password.size(),
-                     block.data(), block.size(), u.data() );
+        hmac_sha256( hmac, block.data(), block.size(), u );
 
-        std::memcpy( t.data(), u.data(), sha256::HASH_SIZE );
+        std::memcpy( t, u, sha256::HASH_SIZE );
 
         for( uint32_t j = 1; j < iterations; ++j )
         {
-            hmac_sha256( ( const uint8_t * )password.data(), password.size(),
-                         u.data(), sha256::HASH_SIZE, u.data() );
+            hmac_sha256_digest( hmac, u, u );
             for( size_t k = 0; k < sha256::HASH_SIZE; ++k )
                 t[ k ] ^= u[ k ];
         }
 
         size_t offset = ( i - 1 ) * sha256::HASH_SIZE;
         size_t chunk = (std::min)( dkLen - offset, sha256::HASH_SIZE );
-        std::memcpy( &key[ offset ], t.data(), chunk );
+        std::memcpy( &key[ offset ], t, chunk );
     }
 
     return key;
@@ -295,5 +376,38 @@ inline std::vector<uint8_t> Base64Decode( const std::string &input )
     return decoded;
 }
 
+// One derivation for pbkdf2_hmac_sha256_batch.
+struct Pbkdf2Job {
+    std::string password;
+    std::vector<uint8_t> salt;
+    uint32_t iterations = 0;
+    size_t length = 0;
+    std::vector<uint8_t> derived;
+};
+
+// Fill in derived for every job. Jobs that share an iteration count and
+// fit in one SHA-256 output are run eight at a time through the AVX2
+// multi-buffer path when it is available; the rest go through
+// pbkdf2_hmac_sha256 one by one.
+void pbkdf2_hmac_sha256_batch( std::span< Pbkdf2Job * > jobs );
+
+// Stored hashes look like pbkdf2$<iterations>$<salt b64>$<key b64>.
+std::vector<uint8_t> GeneratePasswordSalt( size_t saltLen );
+std::string FormatPasswordHash( uint32_t iterations, const std::vector<uint8_t> &salt, const std::vector<uint8_t> &derived );
+bool ParsePasswordHash( const std::string &storedHash, uint32_t &iterations, std::vector<uint8_t> &salt, std::vector<uint8_t> &expected );
+
+// Iteration count for new hashes. CalibratePasswordIterations times the
+// derivation on this machine and picks the count that takes roughly
+// budgetMs per login, never going below PASSWORD_MIN_ITERATIONS. Stored
+// hashes weaker than half the target are rehashed on the next successful
+// login. Stronger hashes are never lowered, since the target is only a
+// startup timing measurement.
+constexpr uint32_t PASSWORD_MIN_ITERATIONS = 1000;
+constexpr uint32_t PASSWORD_MAX_ITERATIONS = 10000000;
+
+uint32_t CalibratePasswordIterations( uint32_t budgetMs );
+uint32_t GetPasswordIterations();
+bool PasswordNeedsRehash( uint32_t iterations );
+
 std::string HashPassword( const std::string &password, uint32_t iterations, size_t saltLen );
 bool VerifyPassword( const std::string &password, const std::string &storedHash );
\ No newline at end of file
@@ -1,3 +1,5 @@
+#include <cstring>
+#include <cwchar>
 
 #include "RealmCrypt.h"
 #include "../Common/Utility.h"
@@ -27,6 +29,12 @@ std::vector<uint8_t> RealmCrypt::getSymmetricKey( void )
 	return default_sym_key;
 }
 
+const AesContext &RealmCrypt::getContext()
+{
+	static const AesContext context( default_sym_key );
+	return context;
+}
+
 std::string RealmCrypt::encryptString( std::string &input )
 {
 	if( input.size() % 16 != 0 )
@@ -34,15 +42,14 @@ std::string RealmCrypt::encryptString( std::string &input )
 		input.append( 16 - ( input.size() % 16 ), '\0' );
 	}
 
-	rijndael aes;
+	std::string output( input.size(), '\0' );
 
-	auto result = aes.EncryptECB(
-		reinterpret_cast< const uint8_t * >( input.c_str() ),
-		static_cast< uint32_t >( input.size() ),
-		default_sym_key.data()
+	getContext().Encrypt(
+		std::span( reinterpret_cast< const uint8_t * >( input.data() ), input.size() ),
+		std::span( reinterpret_cast< uint8_t * >( output.data() ), output.size() )
 	);
 
-	return std::string( reinterpret_cast< const char * >( result ), input.size() );
+	return output;
 }
 
 std::string RealmCrypt::decryptString( std::string &input )
@@ -52,44 +59,27 @@ std::string RealmCrypt::decryptString( std::string &input )
 		input.append( 16 - ( input.size() % 16 ), '\0' );
 	}
 
-	rijndael aes;
+	std::string output( input.size(), '\0' );
 
-	auto result = aes.DecryptECB( reinterpret_cast< const uint8_t * >(
-		input.c_str() ),
-		static_cast< uint32_t >( input.size() ),
-		default_sym_key.data()
+	getContext().Decrypt(
+		std::span( reinterpret_cast< const uint8_t * >( input.data() ), input.size() ),
+		std::span( reinterpret_cast< uint8_t * >( output.data() ), output.size() )
 	);
 
-	return std::string( reinterpret_cast< const char * >( result ), input.size() );
+	return output;
 }
 
 std::vector<uint8_t> RealmCrypt::encryptString( const std::wstring &input )
 {
-	// Convert UTF-16 string to raw bytes
-	std::vector<uint8_t> utf16Bytes;
-	utf16Bytes.reserve( input.size() * 2 );
-	for( wchar_t ch : input )
-	{
-		utf16Bytes.push_back( static_cast< uint8_t >( ch & 0xFF ) );
-		utf16Bytes.push_back( static_cast< uint8_t >( ( ch >> 8 ) & 0xFF ) );
-	}
-
-	// Pad to nearest 16 bytes
-	if( utf16Bytes.size() % 16 != 0 )
-	{
-		utf16Bytes.resize( ( utf16Bytes.size() / 16 + 1 ) * 16, 0 );
-	}
+	// Copy the UTF-16 units, zero padded to the nearest 16 bytes
+	const size_t byteLength = input.size() * 2;
+	std::vector<uint8_t> utf16Bytes( ( byteLength + 15 ) & ~size_t( 15 ), 0 );
+	std::memcpy( utf16Bytes.data(), input.data(), byteLength );
 
-	// Encrypt using AES ECB
-	rijndael aes;
-	auto encrypted = aes.EncryptECB(
-		reinterpret_cast< const uint8_t * >( utf16Bytes.data() ),
-		static_cast< uint32_t >( utf16Bytes.size() ),
-		default_sym_key.data()
-	);
+	// Encrypt in place using AES ECB
+	getContext().Encrypt( utf16Bytes, utf16Bytes );
 
-	// Return the raw encrypted bytes
-	return std::vector<uint8_t>( encrypted, encrypted + utf16Bytes.size() );
+	return utf16Bytes;
 }
 
 std::wstring RealmCrypt::decryptString( std::vector<uint8_t> &input )
@@ -100,64 +90,47 @@ std::wstring RealmCrypt::decryptString( std::vector<uint8_t> &input )
 		input.resize( ( input.size() / 16 + 1 ) * 16, 0 );
 	}
 
-	rijndael aes;
-
-	auto result = aes.DecryptECB(
-		reinterpret_cast< const uint8_t * >( input.data() ),
-		static_cast< uint32_t >( input.size() ),
-		default_sym_key.data()
-	);
+	std::vector< uint8_t > decrypted( input.size() );
+	getContext().Decrypt( input, decrypted );
 
-	// Convert decrypted bytes back into a wstring
-	std::wstring output;
-	output.reserve( input.size() / 2 );
+	// Copy the decrypted units back out, stopping at a null terminator
+	std::wstring output( decrypted.size() / 2, L'\0' );
+	std::memcpy( output.data(), decrypted.data(), output.size() * 2 );
 
-	for( size_t i = 0; i + 1 < input.size(); i += 2 )
-	{
-		uint16_t ch = static_cast< uint16_t >( input[ i ] | ( input[ i + 1 ] << 8 ) );
-		if( ch == 0 ) break; // Optional: stop at null terminator
-		output.push_back( static_cast< wchar_t >( ch ) );
-	}
+	output.resize( std::wcslen( output.c_str() ) );
 
 	return output;
 }
 
-std::vector< uint8_t > RealmCrypt::encryptSymmetric( std::span< const uint8_t > input )
+CachedCipherText RealmCrypt::cacheString( const std::wstring &input )
 {
-	if( input.size() % 16 != 0 )
-	{
-		std::vector< uint8_t > paddedInput( input.begin(), input.end() );
-		paddedInput.resize( ( ( input.size() / 16 ) + 1 ) * 16, 0 );
-		input = paddedInput;
-	}
+	const auto bytes = reinterpret_cast< const uint8_t * >( input.data() );
+
+	return { input, encryptSymmetric( std::span( bytes, input.size() * 2 ) ) };
+}
 
-	rijndael aes;
+std::vector< uint8_t > RealmCrypt::encryptSymmetric( std::span< const uint8_t > input )
+{
+	// Zero pad up to the block size and encrypt in place.
+	std::vector< uint8_t > output( ( input.size() + 15 ) & ~size_t( 15 ), 0 );
+	std::copy( input.begin(), input.end(), output.begin() );
 
-	auto result = aes.EncryptECB( reinterpret_cast< const uint8_t * >(
-		input.data() ),
-		static_cast< uint32_t >( input.size() ),
-		default_sym_key.data()
-	);
+	getContext().Encrypt( output, output );
 
-	return std::vector< uint8_t >( result, result + input.size() );
+	return output;
 }
 
 std::vector< uint8_t > RealmCrypt::decryptSymmetric( std::span< const uint8_t > input )
 {
-	if( input.size() % 16 != 0 )
-	{
-		std::vector< uint8_t > paddedInput( input.begin(), input.end() );
-		paddedInput.resize( ( ( input.size() / 16 ) + 1 ) * 16, 0 );
-		input = paddedInput;
-	}
+	std::vector< uint8_t > output( ( input.size() + 15 ) & ~size_t( 15 ), 0 );
+	std::copy( input.begin(), input.end(), output.begin() );
 
-	rijndael aes;
+	getContext().Decrypt( output, output );
 
-	auto result = aes.DecryptECB( reinterpret_cast< const uint8_t * >(
-		input.data() ),
-		static_cast< uint32_t >( input.size() ),
-		default_sym_key.data()
-	);
+	return output;
+}
 
-	return std::vector< uint8_t >( result, result + input.size() );
+void RealmCrypt::decryptSymmetricBatch( std::span< uint8_t > payloads )
+{
+	getContext().Decrypt( payloads, payloads );
 }
\ No newline at end of file
@@ -4,7 +4,21 @@
 #include <vector>
 #include <span>
 
-#include "rijndael.h"
+#include "AesContext.h"
+
+// The wire format is UTF-16LE. The server targets Windows, where wchar_t
+// is already a UTF-16 code unit, so protocol strings are copied to and
+// from the wire as raw bytes with no per-character conversion.
+static_assert( sizeof( wchar_t ) == 2, "protocol strings assume a 16-bit wchar_t" );
+
+// A string kept together with its encrypted UTF-16 wire form. Used for
+// values like the session ID that cross the wire over and over without
+// changing, so they can be compared and re-sent without touching AES.
+struct CachedCipherText
+{
+	std::wstring plain;
+	std::vector< uint8_t > cipher;
+};
 
 // This class is based on the games Encryptor class,
 // and is a wrapper around the rijndael ECB implementation.
@@ -24,6 +38,9 @@ private:
 		0x4b, 0x44, 0x4a, 0x20, 0x77, 0x64, 0x61, 0x6a
 	};
 
+	// Key schedule for default_sym_key, expanded on first use.
+	static const AesContext &getContext();
+
 public:
 	RealmCrypt();
 
@@ -36,8 +53,13 @@ public:
 	static std::string decryptString( std::string &input );
 	static std::vector<uint8_t> encryptString( const std::wstring &input );
 	static std::wstring decryptString( std::vector<uint8_t> &input );
+	static CachedCipherText cacheString( const std::wstring &input );
 
 	// Encrypt and decrypt byte arrays.
 	static std::vector< uint8_t > encryptSymmetric( std::span< const uint8_t > input );
 	static std::vector< uint8_t > decryptSymmetric( std::span< const uint8_t > input );
+
+	// Decrypt a run of block-aligned payloads in place with one call, so
+	// unrelated packets share the interleaved hardware rounds.
+	static void decryptSymmetricBatch( std::span< uint8_t > payloads );
 };
\ No newline at end of file
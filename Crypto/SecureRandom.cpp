@@ -0,0 +1,130 @@
+#include "SecureRandom.h"
+
+#include <algorithm>
+#include <cstring>
+#include <random>
+
+namespace
+{
+	uint32_t RotateLeft( uint32_t value, int count )
+	{
+		return ( value << count ) | ( value >> ( 32 - count ) );
+	}
+
+	void QuarterRound( uint32_t &a, uint32_t &b, uint32_t &c, uint32_t &d )
+	{
+		a += b; d ^= a; d = RotateLeft( d, 16 );
+		c += d; b ^= c; b = RotateLeft( b, 12 );
+		a += b; d ^= a; d = RotateLeft( d, 8 );
+		c += d; b ^= c; b = RotateLeft( b, 7 );
+	}
+
+	// RFC 8439 block function with a zero nonce.
+	void ChaChaBlock( const uint32_t key[ 8 ], uint32_t counter, uint8_t out[ 64 ] )
+	{
+		uint32_t input[ 16 ] = {
+			0x61707865, 0x3320646e, 0x79622d32, 0x6b206574,
+			key[ 0 ], key[ 1 ], key[ 2 ], key[ 3 ],
+			key[ 4 ], key[ 5 ], key[ 6 ], key[ 7 ],
+			counter, 0, 0, 0
+		};
+
+		uint32_t x[ 16 ];
+		std::memcpy( x, input, sizeof( x ) );
+
+		for( int i = 0; i < 10; i++ )
+		{
+			QuarterRound( x[ 0 ], x[ 4 ], x[ 8 ], x[ 12 ] );
+			QuarterRound( x[ 1 ], x[ 5 ], x[ 9 ], x[ 13 ] );
+			QuarterRound( x[ 2 ], x[ 6 ], x[ 10 ], x[ 14 ] );
+			QuarterRound( x[ 3 ], x[ 7 ], x[ 11 ], x[ 15 ] );
+			QuarterRound( x[ 0 ], x[ 5 ], x[ 10 ], x[ 15 ] );
+			QuarterRound( x[ 1 ], x[ 6 ], x[ 11 ], x[ 12 ] );
+			QuarterRound( x[ 2 ], x[ 7 ], x[ 8 ], x[ 13 ] );
+			QuarterRound( x[ 3 ], x[ 4 ], x[ 9 ], x[ 14 ] );
+		}
+
+		for( int i = 0; i < 16; i++ )
+		{
+			const uint32_t word = x[ i ] + input[ i ];
+			out[ i * 4 + 0 ] = static_cast< uint8_t >( word );
+			out[ i * 4 + 1 ] = static_cast< uint8_t >( word >> 8 );
+			out[ i * 4 + 2 ] = static_cast< uint8_t >( word >> 16 );
+			out[ i * 4 + 3 ] = static_cast< uint8_t >( word >> 24 );
+		}
+	}
+
+	class Generator
+	{
+	public:
+		Generator()
+		{
+			std::random_device rd;
+			for( auto &word : m_key )
+			{
+				word = rd();
+			}
+		}
+
+		void Fill( std::span< uint8_t > out )
+		{
+			while( !out.empty() )
+			{
+				if( m_available == 0 )
+				{
+					Refill();
+				}
+
+				const size_t take = std::min( out.size(), m_available );
+				const uint8_t *source = m_buffer + sizeof( m_buffer ) - m_available;
+
+				std::memcpy( out.data(), source, take );
+				std::memset( const_cast< uint8_t * >( source ), 0, take );
+
+				m_available -= take;
+				out = out.subspan( take );
+			}
+		}
+
+	private:
+		void Refill()
+		{
+			uint8_t block[ 64 ];
+			ChaChaBlock( m_key, m_counter++, block );
+
+			// First half becomes the next key, second half is output.
+			std::memcpy( m_key, block, sizeof( m_key ) );
+			std::memcpy( m_buffer, block + sizeof( m_key ), sizeof( m_buffer ) );
+			std::memset( block, 0, sizeof( block ) );
+
+			m_available = sizeof( m_buffer );
+		}
+
+		uint32_t m_key[ 8 ];
+		uint32_t m_counter = 0;
+		uint8_t m_buffer[ 32 ] = {};
+		size_t m_available = 0;
+	};
+
+	Generator &ThreadGenerator()
+	{
+		thread_local Generator generator;
+		return generator;
+	}
+}
+
+void SecureRandom::Fill( std::span< uint8_t > out )
+{
+	ThreadGenerator().Fill( out );
+}
+
+uint64_t SecureRandom::NextU64()
+{
+	uint8_t bytes[ 8 ];
+	Fill( bytes );
+
+	uint64_t value;
+	std::memcpy( &value, bytes, sizeof( value ) );
+
+	return value;
+}
\ No newline at end of file
@@ -0,0 +1,18 @@
+#pragma once
+
+#include <cstdint>
+#include <span>
+
+// Per-thread ChaCha20 generator for values that must not be guessable
+// (session tokens, password salts).
+//
+// Each thread seeds its own key from std::random_device, which is backed
+// by the OS CSPRNG on Windows, so there is no shared state and no lock.
+// Every block rekeys the generator from its own output before handing
+// out the rest, so earlier outputs cannot be recovered from a later
+// state.
+namespace SecureRandom
+{
+	void Fill( std::span< uint8_t > out );
+	uint64_t NextU64();
+}
\ No newline at end of file
@@ -0,0 +1,326 @@
+#include "Sha256Simd.h"
+#include "PasswordHash.h"
+
+#include <array>
+
+#if defined( _M_X64 ) || defined( _M_IX86 ) || defined( __x86_64__ ) || defined( __i386__ )
+#define SHA_SIMD_X86 1
+#endif
+
+namespace
+{
+	consteval std::array< uint32_t, 64 > BuildRoundConstants()
+	{
+		std::array< uint32_t, 64 > k = {};
+		for( uint32_t i = 0; i < 64; i++ )
+		{
+			k[ i ] = sha256::RoundConstant( i );
+		}
+		return k;
+	}
+
+	alignas( 64 ) constexpr std::array< uint32_t, 64 > K = BuildRoundConstants();
+}
+
+#ifdef SHA_SIMD_X86
+
+#include <immintrin.h>
+
+#ifdef _MSC_VER
+#include <intrin.h>
+#define SHANI_TARGET
+#define AVX2_TARGET
+#else
+#include <cpuid.h>
+#define SHANI_TARGET __attribute__( ( target( "sha,sse4.1,ssse3" ) ) )
+#define AVX2_TARGET __attribute__( ( target( "avx2" ) ) )
+#endif
+
+static void CpuId( uint32_t leaf, uint32_t subLeaf, uint32_t regs[ 4 ] )
+{
+#ifdef _MSC_VER
+	int info[ 4 ] = {};
+	__cpuidex( info, static_cast< int >( leaf ), static_cast< int >( subLeaf ) );
+	for( int i = 0; i < 4; i++ )
+	{
+		regs[ i ] = static_cast< uint32_t >( info[ i ] );
+	}
+#else
+	if( !__get_cpuid_count( leaf, subLeaf, &regs[ 0 ], &regs[ 1 ], &regs[ 2 ], &regs[ 3 ] ) )
+	{
+		regs[ 0 ] = regs[ 1 ] = regs[ 2 ] = regs[ 3 ] = 0;
+	}
+#endif
+}
+
+static bool HasShaNi()
+{
+	uint32_t leaf1[ 4 ], leaf7[ 4 ];
+	CpuId( 1, 0, leaf1 );
+	CpuId( 7, 0, leaf7 );
+
+	const bool sse41 = ( leaf1[ 2 ] & ( 1u << 19 ) ) != 0;
+	const bool ssse3 = ( leaf1[ 2 ] & ( 1u << 9 ) ) != 0;
+	const bool sha = ( leaf7[ 1 ] & ( 1u << 29 ) ) != 0;
+
+	return sse41 && ssse3 && sha;
+}
+
+static bool HasAvx2()
+{
+	uint32_t leaf1[ 4 ], leaf7[ 4 ];
+	CpuId( 1, 0, leaf1 );
+	CpuId( 7, 0, leaf7 );
+
+	// The OS also has to save the YMM registers.
+	const bool osxsave = ( leaf1[ 2 ] & ( 1u << 27 ) ) != 0;
+	if( !osxsave )
+	{
+		return false;
+	}
+
+#ifdef _MSC_VER
+	const uint64_t xcr0 = _xgetbv( 0 );
+#else
+	uint32_t eax, edx;
+	__asm__( "xgetbv" : "=a"( eax ), "=d"( edx ) : "c"( 0 ) );
+	const uint64_t xcr0 = ( uint64_t( edx ) << 32 ) | eax;
+#endif
+
+	return ( xcr0 & 0x6 ) == 0x6 && ( leaf7[ 1 ] & ( 1u << 5 ) ) != 0;
+}
+
+SHANI_TARGET
+void Sha256Simd::TransformShaNi( uint32_t state[ 8 ], const uint8_t block[ 64 ] )
+{
+	const __m128i byteSwap = _mm_set_epi64x( 0x0c0d0e0f08090a0bULL, 0x0405060700010203ULL );
+
+	// Reorder the state into the ABEF/CDGH layout sha256rnds2 expects.
+	__m128i tmp = _mm_shuffle_epi32( _mm_loadu_si128( reinterpret_cast< const __m128i * >( state ) ), 0xB1 );
+	__m128i state1 = _mm_shuffle_epi32( _mm_loadu_si128( reinterpret_cast< const __m128i * >( state + 4 ) ), 0x1B );
+	__m128i state0 = _mm_alignr_epi8( tmp, state1, 8 );
+	state1 = _mm_blend_epi16( state1, tmp, 0xF0 );
+
+	const __m128i abefSave = state0;
+	const __m128i cdghSave = state1;
+
+	__m128i msg[ 4 ];
+	for( int i = 0; i < 4; i++ )
+	{
+		msg[ i ] = _mm_shuffle_epi8( _mm_loadu_si128( reinterpret_cast< const __m128i * >( block + i * 16 ) ), byteSwap );
+	}
+
+	// Sixteen groups of four rounds; msg[] is a ring of the last four
+	// message groups and each new group is scheduled from it in place.
+	for( int group = 0; group < 16; group++ )
+	{
+		if( group >= 4 )
+		{
+			__m128i &w = msg[ group & 3 ];
+			const __m128i &w1 = msg[ ( group - 1 ) & 3 ];
+			const __m128i &w2 = msg[ ( group - 2 ) & 3 ];
+			const __m128i &w3 = msg[ ( group - 3 ) & 3 ];
+
+			w = _mm_sha256msg1_epu32( w, w3 );
+			w = _mm_add_epi32( w, _mm_alignr_epi8( w1, w2, 4 ) );
+			w = _mm_sha256msg2_epu32( w, w1 );
+		}
+
+		__m128i wk = _mm_add_epi32( msg[ group & 3 ], _mm_load_si128( reinterpret_cast< const __m128i * >( K.data() + group * 4 ) ) );
+		state1 = _mm_sha256rnds2_epu32( state1, state0, wk );
+		wk = _mm_shuffle_epi32( wk, 0x0E );
+		state0 = _mm_sha256rnds2_epu32( state0, state1, wk );
+	}
+
+	state0 = _mm_add_epi32( state0, abefSave );
+	state1 = _mm_add_epi32( state1, cdghSave );
+
+	// Back to ABCD/EFGH.
+	tmp = _mm_shuffle_epi32( state0, 0x1B );
+	state1 = _mm_shuffle_epi32( state1, 0xB1 );
+	state0 = _mm_blend_epi16( tmp, state1, 0xF0 );
+	state1 = _mm_alignr_epi8( state1, tmp, 8 );
+
+	_mm_storeu_si128( reinterpret_cast< __m128i * >( state ), state0 );
+	_mm_storeu_si128( reinterpret_cast< __m128i * >( state + 4 ), state1 );
+}
+
+namespace
+{
+	AVX2_TARGET inline __m256i RotR( __m256i x, int n )
+	{
+		return _mm256_or_si256( _mm256_srli_epi32( x, n ), _mm256_slli_epi32( x, 32 - n ) );
+	}
+}
+
+AVX2_TARGET
+void Sha256Simd::Transform8( uint32_t state[ 8 ][ LANES ], const uint32_t block[ 16 ][ LANES ] )
+{
+	__m256i w[ 16 ];
+	for( int i = 0; i < 16; i++ )
+	{
+		w[ i ] = _mm256_loadu_si256( reinterpret_cast< const __m256i * >( block[ i ] ) );
+	}
+
+	__m256i s[ 8 ];
+	for( int i = 0; i < 8; i++ )
+	{
+		s[ i ] = _mm256_loadu_si256( reinterpret_cast< const __m256i * >( state[ i ] ) );
+	}
+
+	__m256i a = s[ 0 ], b = s[ 1 ], c = s[ 2 ], d = s[ 3 ];
+	__m256i e = s[ 4 ], f = s[ 5 ], g = s[ 6 ], h = s[ 7 ];
+
+	for( int i = 0; i < 64; i++ )
+	{
+		__m256i m;
+		if( i < 16 )
+		{
+			m = w[ i ];
+		}
+		else
+		{
+			const __m256i w2 = w[ ( i - 2 ) & 15 ];
+			const __m256i w15 = w[ ( i - 15 ) & 15 ];
+
+			const __m256i sigma1 = _mm256_xor_si256( _mm256_xor_si256( RotR( w2, 17 ), RotR( w2, 19 ) ), _mm256_srli_epi32( w2, 10 ) );
+			const __m256i sigma0 = _mm256_xor_si256( _mm256_xor_si256( RotR( w15, 7 ), RotR( w15, 18 ) ), _mm256_srli_epi32( w15, 3 ) );
+
+			m = _mm256_add_epi32( _mm256_add_epi32( sigma1, w[ ( i - 7 ) & 15 ] ), _mm256_add_epi32( sigma0, w[ i & 15 ] ) );
+			w[ i & 15 ] = m;
+		}
+
+		const __m256i bigSigma1 = _mm256_xor_si256( _mm256_xor_si256( RotR( e, 6 ), RotR( e, 11 ) ), RotR( e, 25 ) );
+		const __m256i ch = _mm256_xor_si256( _mm256_and_si256( e, f ), _mm256_andnot_si256( e, g ) );
+		const __m256i t1 = _mm256_add_epi32(
+			_mm256_add_epi32( _mm256_add_epi32( h, bigSigma1 ), _mm256_add_epi32( ch, m ) ),
+			_mm256_set1_epi32( static_cast< int >( K[ i ] ) ) );
+
+		const __m256i bigSigma0 = _mm256_xor_si256( _mm256_xor_si256( RotR( a, 2 ), RotR( a, 13 ) ), RotR( a, 22 ) );
+		const __m256i maj = _mm256_xor_si256( _mm256_xor_si256( _mm256_and_si256( a, b ), _mm256_and_si256( a, c ) ), _mm256_and_si256( b, c ) );
+		const __m256i t2 = _mm256_add_epi32( bigSigma0, maj );
+
+		h = g; g = f; f = e;
+		e = _mm256_add_epi32( d, t1 );
+		d = c; c = b; b = a;
+		a = _mm256_add_epi32( t1, t2 );
+	}
+
+	const __m256i out[ 8 ] = { a, b, c, d, e, f, g, h };
+	for( int i = 0; i < 8; i++ )
+	{
+		_mm256_storeu_si256( reinterpret_cast< __m256i * >( state[ i ] ), _mm256_add_epi32( s[ i ], out[ i ] ) );
+	}
+}
+
+#else
+
+static bool HasShaNi()
+{
+	return false;
+}
+
+static bool HasAvx2()
+{
+	return false;
+}
+
+void Sha256Simd::TransformShaNi( uint32_t *, const uint8_t * )
+{
+}
+
+void Sha256Simd::Transform8( uint32_t[ 8 ][ LANES ], const uint32_t[ 16 ][ LANES ] )
+{
+}
+
+#endif
+
+// Known-answer block shared by the self-tests.
+static void FillTestBlock( uint8_t block[ 64 ], uint32_t seed )
+{
+	for( uint32_t i = 0; i < 64; i++ )
+	{
+		block[ i ] = static_cast< uint8_t >( i * 37 + seed * 11 + 5 );
+	}
+}
+
+bool Sha256Simd::UseShaNi()
+{
+	static const bool useShaNi = []()
+	{
+		if( !HasShaNi() )
+		{
+			return false;
+		}
+
+		uint8_t block[ 64 ];
+		FillTestBlock( block, 0 );
+
+		sha256::Context soft;
+		sha256::Init( soft );
+		sha256::TransformScalar( soft, block );
+
+		uint32_t hard[ 8 ];
+		std::memcpy( hard, soft.state, sizeof( hard ) );
+		sha256::TransformScalar( soft, block );
+		TransformShaNi( hard, block );
+
+		return std::memcmp( hard, soft.state, sizeof( hard ) ) == 0;
+	}();
+
+	return useShaNi;
+}
+
+bool Sha256Simd::UseAvx2()
+{
+	static const bool useAvx2 = []()
+	{
+		if( !HasAvx2() )
+		{
+			return false;
+		}
+
+		uint32_t state[ 8 ][ LANES ];
+		uint32_t words[ 16 ][ LANES ];
+		sha256::Context soft[ LANES ];
+
+		for( uint32_t lane = 0; lane < LANES; lane++ )
+		{
+			uint8_t block[ 64 ];
+			FillTestBlock( block, lane );
+
+			sha256::Init( soft[ lane ] );
+			soft[ lane ].state[ 0 ] += lane;
+
+			for( uint32_t i = 0; i < 8; i++ )
+			{
+				state[ i ][ lane ] = soft[ lane ].state[ i ];
+			}
+
+			for( uint32_t i = 0; i < 16; i++ )
+			{
+				words[ i ][ lane ] = ( uint32_t( block[ i * 4 ] ) << 24 ) | ( uint32_t( block[ i * 4 + 1 ] ) << 16 )
+					| ( uint32_t( block[ i * 4 + 2 ] ) << 8 ) | uint32_t( block[ i * 4 + 3 ] );
+			}
+
+			sha256::TransformScalar( soft[ lane ], block );
+		}
+
+		Transform8( state, words );
+
+		for( uint32_t lane = 0; lane < LANES; lane++ )
+		{
+			for( uint32_t i = 0; i < 8; i++ )
+			{
+				if( state[ i ][ lane ] != soft[ lane ].state[ i ] )
+				{
+					return false;
+				}
+			}
+		}
+
+		return true;
+	}();
+
+	return useAvx2;
+}
\ No newline at end of file
@@ -0,0 +1,28 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+// Hardware backends for the sha256 code in PasswordHash.h.
+//
+// TransformShaNi is a drop-in replacement for sha256::Transform on CPUs
+// with the SHA extensions. Transform8 runs eight independent compressions
+// in lockstep with AVX2, one per 32-bit lane, which is what the batched
+// PBKDF2 path uses to derive several passwords at once.
+//
+// The in-tree SHA-256 uses its own round constants, so each backend is
+// checked against the scalar code once per process before it is used.
+namespace Sha256Simd
+{
+	constexpr size_t LANES = 8;
+
+	// True if the CPU has the instructions and the self-test passed.
+	bool UseShaNi();
+	bool UseAvx2();
+
+	void TransformShaNi( uint32_t state[ 8 ], const uint8_t block[ 64 ] );
+
+	// state[ word ][ lane ]; block holds the sixteen message words per lane,
+	// already decoded from big-endian.
+	void Transform8( uint32_t state[ 8 ][ LANES ], const uint32_t block[ 16 ][ LANES ] );
+}
\ No newline at end of file
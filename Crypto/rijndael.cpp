@@ -1,4 +1,5 @@
 #include "rijndael.h"
+#include "AesNi.h"
 
 rijndael::rijndael()
 {
@@ -13,9 +14,17 @@ uint8_t *rijndael::EncryptECB( const uint8_t in[], uint32_t inLen,
 	uint8_t *out = new uint8_t[ inLen ];
 	uint8_t *roundKeys = new uint8_t[ 4 * Nb * ( Nr + 1 ) ];
 	KeyExpansion( key, roundKeys );
-	for( uint32_t i = 0; i < inLen; i += blockBytesLen )
+
+	if( UseHardware() )
+	{
+		AesNi::EncryptECB( roundKeys, Nr, in, out, inLen );
+	}
+	else
 	{
-		EncryptBlock( in + i, out + i, roundKeys );
+		for( uint32_t i = 0; i < inLen; i += blockBytesLen )
+		{
+			EncryptBlock( in + i, out + i, roundKeys );
+		}
 	}
 
 	delete[] roundKeys;
@@ -31,9 +40,18 @@ uint8_t *rijndael::DecryptECB( const uint8_t in[], uint32_t inLen,
 	uint8_t *roundKeys = new uint8_t[ 4 * Nb * ( Nr + 1 ) ];
 	KeyExpansion( key, roundKeys );
 
-	for( uint32_t i = 0; i < inLen; i += blockBytesLen )
+	if( UseHardware() )
+	{
+		uint8_t decryptKeys[ 4 * Nb * 15 ];
+		AesNi::InvertKeys( roundKeys, Nr, decryptKeys );
+		AesNi::DecryptECB( decryptKeys, Nr, in, out, inLen );
+	}
+	else
 	{
-		DecryptBlock( in + i, out + i, roundKeys );
+		for( uint32_t i = 0; i < inLen; i += blockBytesLen )
+		{
+			DecryptBlock( in + i, out + i, roundKeys );
+		}
 	}
 
 	delete[] roundKeys;
@@ -41,6 +59,47 @@ uint8_t *rijndael::DecryptECB( const uint8_t in[], uint32_t inLen,
 	return out;
 }
 
+bool rijndael::UseHardware()
+{
+	static const bool useHardware = []()
+	{
+		if( !AesNi::IsSupported() )
+		{
+			return false;
+		}
+
+		// FIPS-197 Appendix C.3, AES-256
+		const uint8_t key[ 32 ] = {
+			0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0x0a, 0x0b, 0x0c, 0x0d, 0x0e, 0x0f,
+			0x10, 0x11, 0x12, 0x13, 0x14, 0x15, 0x16, 0x17, 0x18, 0x19, 0x1a, 0x1b, 0x1c, 0x1d, 0x1e, 0x1f
+		};
+		const uint8_t plain[ 16 ] = {
+			0x00, 0x11, 0x22, 0x33, 0x44, 0x55, 0x66, 0x77, 0x88, 0x99, 0xaa, 0xbb, 0xcc, 0xdd, 0xee, 0xff
+		};
+		const uint8_t cipher[ 16 ] = {
+			0x8e, 0xa2, 0xb7, 0xca, 0x51, 0x67, 0x45, 0xbf, 0xea, 0xfc, 0x49, 0x90, 0x4b, 0x49, 0x60, 0x89
+		};
+
+		rijndael soft;
+		uint8_t roundKeys[ 4 * Nb * 15 ];
+		soft.KeyExpansion( key, roundKeys );
+
+		uint8_t decryptKeys[ 4 * Nb * 15 ];
+		AesNi::InvertKeys( roundKeys, soft.Nr, decryptKeys );
+
+		uint8_t softOut[ 16 ], hardOut[ 16 ], hardBack[ 16 ];
+		soft.EncryptBlock( plain, softOut, roundKeys );
+		AesNi::EncryptECB( roundKeys, soft.Nr, plain, hardOut, 16 );
+		AesNi::DecryptECB( decryptKeys, soft.Nr, hardOut, hardBack, 16 );
+
+		return std::memcmp( softOut, cipher, 16 ) == 0
+			&& std::memcmp( hardOut, cipher, 16 ) == 0
+			&& std::memcmp( hardBack, plain, 16 ) == 0;
+	}();
+
+	return useHardware;
+}
+
 void rijndael::CheckLength( uint32_t len )
 {
 	if( len % blockBytesLen != 0 )
@@ -51,7 +110,7 @@ void rijndael::CheckLength( uint32_t len )
 }
 
 void rijndael::EncryptBlock( const uint8_t in[], uint8_t out[],
-							 uint8_t *roundKeys )
+							 const uint8_t *roundKeys ) const
 {
 	uint8_t state[ 4 ][ Nb ];
 	uint32_t i, j, round;
@@ -88,7 +147,7 @@ void rijndael::EncryptBlock( const uint8_t in[], uint8_t out[],
 }
 
 void rijndael::DecryptBlock( const uint8_t in[], uint8_t out[],
-							 uint8_t *roundKeys )
+							 const uint8_t *roundKeys ) const
 {
 	uint8_t state[ 4 ][ Nb ];
 	uint32_t i, j, round;
@@ -124,7 +183,7 @@ void rijndael::DecryptBlock( const uint8_t in[], uint8_t out[],
 	}
 }
 
-void rijndael::SubBytes( uint8_t state[ 4 ][ Nb ] )
+void rijndael::SubBytes( uint8_t state[ 4 ][ Nb ] ) const
 {
 	uint32_t i, j;
 	uint8_t t;
@@ -139,7 +198,7 @@ void rijndael::SubBytes( uint8_t state[ 4 ][ Nb ] )
 }
 
 void rijndael::ShiftRow( uint8_t state[ 4 ][ Nb ], uint32_t i,
-						 uint32_t n )  // shift row i on n write_positions
+						 uint32_t n ) const  // shift row i on n write_positions
 {
 	uint8_t tmp[ Nb ];
 	for( uint32_t j = 0; j < Nb; j++ )
@@ -149,19 +208,19 @@ void rijndael::ShiftRow( uint8_t state[ 4 ][ Nb ], uint32_t i,
 	memcpy( state[ i ], tmp, Nb * sizeof( uint8_t ) );
 }
 
-void rijndael::ShiftRows( uint8_t state[ 4 ][ Nb ] )
+void rijndael::ShiftRows( uint8_t state[ 4 ][ Nb ] ) const
 {
 	ShiftRow( state, 1, 1 );
 	ShiftRow( state, 2, 2 );
 	ShiftRow( state, 3, 3 );
 }
 
-uint8_t rijndael::xtime( uint8_t b )  // multiply on x
+uint8_t rijndael::xtime( uint8_t b ) const  // multiply on x
 {
 	return ( b << 1 ) ^ ( ( ( b >> 7 ) & 1 ) * 0x1b );
 }
 
-void rijndael::MixColumns( uint8_t state[ 4 ][ Nb ] )
+void rijndael::MixColumns( uint8_t state[ 4 ][ Nb ] ) const
 {
 	uint8_t temp_state[ 4 ][ Nb ];
 
@@ -190,7 +249,7 @@ void rijndael::MixColumns( uint8_t state[ 4 ][ Nb ] )
 	}
 }
 
-void rijndael::AddRoundKey( uint8_t state[ 4 ][ Nb ], uint8_t *key )
+void rijndael::AddRoundKey( uint8_t state[ 4 ][ Nb ], const uint8_t *key ) const
 {
 	uint32_t i, j;
 	for( i = 0; i < 4; i++ )
@@ -202,7 +261,7 @@ void rijndael::AddRoundKey( uint8_t state[ 4 ][ Nb ], uint8_t *key )
 	}
 }
 
-void rijndael::SubWord( uint8_t *a )
+void rijndael::SubWord( uint8_t *a ) const
 {
 	int i;
 	for( i = 0; i < 4; i++ )
@@ -211,7 +270,7 @@ void rijndael::SubWord( uint8_t *a )
 	}
 }
 
-void rijndael::RotWord( uint8_t *a )
+void rijndael::RotWord( uint8_t *a ) const
 {
 	uint8_t c = a[ 0 ];
 	a[ 0 ] = a[ 1 ];
@@ -220,7 +279,7 @@ void rijndael::RotWord( uint8_t *a )
 	a[ 3 ] = c;
 }
 
-void rijndael::XorWords( uint8_t *a, uint8_t *b, uint8_t *c )
+void rijndael::XorWords( uint8_t *a, uint8_t *b, uint8_t *c ) const
 {
 	int i;
 	for( i = 0; i < 4; i++ )
@@ -229,7 +288,7 @@ void rijndael::XorWords( uint8_t *a, uint8_t *b, uint8_t *c )
 	}
 }
 
-void rijndael::Rcon( uint8_t *a, uint32_t n )
+void rijndael::Rcon( uint8_t *a, uint32_t n ) const
 {
 	uint32_t i;
 	uint8_t c = 1;
@@ -242,7 +301,7 @@ void rijndael::Rcon( uint8_t *a, uint32_t n )
 	a[ 1 ] = a[ 2 ] = a[ 3 ] = 0;
 }
 
-void rijndael::KeyExpansion( const uint8_t key[], uint8_t w[] )
+void rijndael::KeyExpansion( const uint8_t key[], uint8_t w[] ) const
 {
 	uint8_t temp[ 4 ];
 	uint8_t rcon[ 4 ];
@@ -282,7 +341,7 @@ void rijndael::KeyExpansion( const uint8_t key[], uint8_t w[] )
 	}
 }
 
-void rijndael::InvSubBytes( uint8_t state[ 4 ][ Nb ] )
+void rijndael::InvSubBytes( uint8_t state[ 4 ][ Nb ] ) const
 {
 	uint32_t i, j;
 	uint8_t t;
@@ -296,7 +355,7 @@ void rijndael::InvSubBytes( uint8_t state[ 4 ][ Nb ] )
 	}
 }
 
-void rijndael::InvMixColumns( uint8_t state[ 4 ][ Nb ] )
+void rijndael::InvMixColumns( uint8_t state[ 4 ][ Nb ] ) const
 {
 	uint8_t temp_state[ 4 ][ Nb ];
 
@@ -322,7 +381,7 @@ void rijndael::InvMixColumns( uint8_t state[ 4 ][ Nb ] )
 	}
 }
 
-void rijndael::InvShiftRows( uint8_t state[ 4 ][ Nb ] )
+void rijndael::InvShiftRows( uint8_t state[ 4 ][ Nb ] ) const
 {
 	ShiftRow( state, 1, Nb - 1 );
 	ShiftRow( state, 2, Nb - 2 );
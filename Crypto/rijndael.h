@@ -8,6 +8,8 @@
 #include <vector>
 
 class rijndael {
+	friend class AesContext;
+
 private:
 	static constexpr uint32_t Nb = 4;
 	static constexpr uint32_t blockBytesLen = 4 * Nb * sizeof( uint8_t );
@@ -15,41 +17,41 @@ private:
 	uint32_t Nk;
 	uint32_t Nr;
 
-	void SubBytes( uint8_t state[ 4 ][ Nb ] );
+	void SubBytes( uint8_t state[ 4 ][ Nb ] ) const;
 
-	void ShiftRow( uint8_t state[ 4 ][ Nb ], uint32_t i, uint32_t n );
+	void ShiftRow( uint8_t state[ 4 ][ Nb ], uint32_t i, uint32_t n ) const;
 
-	void ShiftRows( uint8_t state[ 4 ][ Nb ] );
+	void ShiftRows( uint8_t state[ 4 ][ Nb ] ) const;
 
-	uint8_t xtime( uint8_t b );
+	uint8_t xtime( uint8_t b ) const;
 
-	void MixColumns( uint8_t state[ 4 ][ Nb ] );
+	void MixColumns( uint8_t state[ 4 ][ Nb ] ) const;
 
-	void AddRoundKey( uint8_t state[ 4 ][ Nb ], uint8_t *key );
+	void AddRoundKey( uint8_t state[ 4 ][ Nb ], const uint8_t *key ) const;
 
-	void SubWord( uint8_t *a );
+	void SubWord( uint8_t *a ) const;
 
-	void RotWord( uint8_t *a );
+	void RotWord( uint8_t *a ) const;
 
-	void XorWords( uint8_t *a, uint8_t *b, uint8_t *c );
+	void XorWords( uint8_t *a, uint8_t *b, uint8_t *c ) const;
 
-	void Rcon( uint8_t *a, uint32_t n );
+	void Rcon( uint8_t *a, uint32_t n ) const;
 
-	void InvSubBytes( uint8_t state[ 4 ][ Nb ] );
+	void InvSubBytes( uint8_t state[ 4 ][ Nb ] ) const;
 
-	void InvMixColumns( uint8_t state[ 4 ][ Nb ] );
+	void InvMixColumns( uint8_t state[ 4 ][ Nb ] ) const;
 
-	void InvShiftRows( uint8_t state[ 4 ][ Nb ] );
+	void InvShiftRows( uint8_t state[ 4 ][ Nb ] ) const;
 
 	void CheckLength( uint32_t len );
 
-	void KeyExpansion( const uint8_t key[], uint8_t w[] );
+	void KeyExpansion( const uint8_t key[], uint8_t w[] ) const;
 
 	void EncryptBlock( const uint8_t in[], uint8_t out[],
-					   uint8_t *roundKeys );
+					   const uint8_t *roundKeys ) const;
 
 	void DecryptBlock( const uint8_t in[], uint8_t out[],
-					   uint8_t *roundKeys );
+					   const uint8_t *roundKeys ) const;
 
 	void XorBlocks( const uint8_t *a, const uint8_t *b,
 					uint8_t *c, uint32_t len );
@@ -58,6 +60,10 @@ private:
 
 	uint8_t *VectorToArray( std::vector<uint8_t> &a );
 
+	// True if AES-NI is present and agrees with the software path on a
+	// known-answer block. Checked once per process.
+	static bool UseHardware();
+
 public:
 	explicit rijndael();
 
@@ -1,6 +1,5 @@
 #include "Database.h"
 
-#include "../../Crypto/PasswordHash.h"
 #include "../../Game/RealmCharacter.h"
 #include "../../Game/RealmCharacterMetaKV.h"
 #include "../logging.h"
@@ -83,6 +82,9 @@ void Database::PrepareStatements()
 		{ QueryID::LoadAccount,
 		"SELECT chat_handle FROM RealmUsers WHERE account_id = ?;" },
 
+		{ QueryID::UpdatePassword,
+		"UPDATE RealmUsers SET password = ? WHERE account_id = ?;" },
+
 		{ QueryID::CreateNewCharacter,
 		"INSERT INTO RealmCharacters ( account_id, meta_data, character_data ) VALUES ( ?, ?, ? );" },
 
@@ -164,14 +166,13 @@ void Database::Execute( const char *sql )
 }
 
 int64_t Database::CreateNewAccount( const std::string &username,
-									const std::string &password,
+									const std::string &passwordHash,
 									const std::string &email_address,
 									const std::string &date_of_birth,
 									const std::string &chat_handle )
 {
 	try
 	{
-		auto hashedPassword = HashPassword( password, 1000, 32 );
 		auto stmt = m_statements[ QueryID::CreateAccount ];
 
 		SQLiteTransaction tx( m_db );
@@ -180,7 +181,7 @@ int64_t Database::CreateNewAccount( const std::string &username,
 			sqlite3_clear_bindings( stmt );
 
 			sqlite3_bind_text( stmt, 1, username.c_str(), -1, SQLITE_TRANSIENT );
-			sqlite3_bind_text( stmt, 2, hashedPassword.c_str(), -1, SQLITE_TRANSIENT );
+			sqlite3_bind_text( stmt, 2, passwordHash.c_str(), -1, SQLITE_TRANSIENT );
 			sqlite3_bind_text( stmt, 3, email_address.c_str(), -1, SQLITE_TRANSIENT );
 			sqlite3_bind_text( stmt, 4, date_of_birth.c_str(), -1, SQLITE_TRANSIENT );
 			sqlite3_bind_text( stmt, 5, chat_handle.c_str(), -1, SQLITE_TRANSIENT );
@@ -202,14 +203,13 @@ int64_t Database::CreateNewAccount( const std::string &username,
 	return 0;
 }
 
-std::tuple< bool, int64_t, std::wstring >
-Database::VerifyAccount( const std::wstring &username, const std::wstring &password )
+std::tuple< bool, int64_t, std::string, std::wstring >
+Database::LoadAccountCredentials( const std::wstring &username )
 {
 	try
 	{
 		auto stmt = m_statements[ QueryID::VerifyAccount ];
 		auto username_utf8 = Util::WideToUTF8( username );
-		auto password_utf8 = Util::WideToUTF8( password );
 
 		sqlite3_reset( stmt );
 		sqlite3_clear_bindings( stmt );
@@ -217,27 +217,25 @@ Database::VerifyAccount( const std::wstring &username, const std::wstring &passw
 		sqlite3_bind_text( stmt, 1, username_utf8.c_str(), -1, SQLITE_TRANSIENT );
 
 		// Execute the statement
-		if( sqlite3_step( stmt ) == SQLITE_ROW )
+		const auto rc = sqlite3_step( stmt );
+
+		if( rc == SQLITE_ROW )
 		{
 			int64_t accountId = sqlite3_column_int64( stmt, 0 );
 			const char *dbUsername = reinterpret_cast< const char * >( sqlite3_column_text( stmt, 1 ) );
 			const char *dbPassword = reinterpret_cast< const char * >( sqlite3_column_text( stmt, 2 ) );
 			const char *dbChatHandle = reinterpret_cast< const char * >( sqlite3_column_text( stmt, 3 ) );
 
-			if( username_utf8 == dbUsername && VerifyPassword( password_utf8, dbPassword ) )
-			{
-				Log::Debug( "Account verified: {} (ID: {})", username, accountId );
-				return std::make_tuple( true, accountId, Util::UTF8ToWide( dbChatHandle ) );
-			}
-			else
+			if( username_utf8 != dbUsername )
 			{
-				Log::Error( "Invalid credentials for account ID: {}", accountId );
-				return std::make_tuple( false, -1, L"" );
+				return std::make_tuple( false, -1, "", L"" );
 			}
+
+			return std::make_tuple( true, accountId, std::string( dbPassword ), Util::UTF8ToWide( dbChatHandle ) );
 		}
-		else if( sqlite3_step( stmt ) == SQLITE_DONE )
+		else if( rc == SQLITE_DONE )
 		{
-			return std::make_tuple( false, -1, L"" ); // No matching account found
+			return std::make_tuple( false, -1, "", L"" ); // No matching account found
 		}
 		else
 		{
@@ -249,7 +247,41 @@ Database::VerifyAccount( const std::wstring &username, const std::wstring &passw
 		Log::Error( "Database error: {}", std::string( e.what() ) );
 	}
 
-	return std::make_tuple( false, -1, L"" );
+	return std::make_tuple( false, -1, "", L"" );
+}
+
+bool Database::UpdatePassword( const int64_t account_id, const std::string &passwordHash )
+{
+	if( account_id <= 0 || passwordHash.empty() )
+	{
+		Log::Error( "Invalid parameters for UpdatePassword" );
+		return false;
+	}
+
+	try
+	{
+		auto stmt = m_statements[ QueryID::UpdatePassword ];
+		SQLiteTransaction tx( m_db );
+		{
+			sqlite3_reset( stmt );
+			sqlite3_clear_bindings( stmt );
+			sqlite3_bind_text( stmt, 1, passwordHash.c_str(), -1, SQLITE_TRANSIENT );
+			sqlite3_bind_int64( stmt, 2, account_id );
+
+			if( sqlite3_step( stmt ) != SQLITE_DONE )
+			{
+				Log::Error( "SQLite update failed: {}", sqlite3_errmsg( m_db ) );
+				return false;
+			}
+		}
+		tx.commit();
+		return true;
+	}
+	catch( const std::exception &e )
+	{
+		Log::Error( "Database error: {}", std::string( e.what() ) );
+	}
+	return false;
 }
 
 uint32_t Database::CreateNewCharacter( const int64_t account_id, const CharacterSlotData meta, const std::vector< uint8_t > &blob )
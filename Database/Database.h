@@ -16,6 +16,7 @@ enum class QueryID {
 	CreateAccount,
 	VerifyAccount,
 	LoadAccount,
+	UpdatePassword,
 
 	LoadCharacterSlots,
 	CreateNewCharacter,
@@ -58,13 +59,18 @@ public:
 	void Process();
 
 public:
+	// The password must already be hashed (see HashPassword).
 	int64_t CreateNewAccount( const std::string &username,
-							  const std::string &password,
+							  const std::string &passwordHash,
 							  const std::string &email_address,
 							  const std::string &date_of_birth,
 							  const std::string &chat_handle );
 
-	std::tuple< bool, int64_t, std::wstring > VerifyAccount( const std::wstring &username, const std::wstring &password );
+	// Returns the account ID, stored password hash and chat handle. The
+	// hash is checked by the caller so it can run off the lobby thread.
+	std::tuple< bool, int64_t, std::string, std::wstring > LoadAccountCredentials( const std::wstring &username );
+
+	bool UpdatePassword( const int64_t account_id, const std::string &passwordHash );
 
 	uint32_t CreateNewCharacter( const int64_t account_id,
 								 const CharacterSlotData meta,
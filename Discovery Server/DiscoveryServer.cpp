@@ -19,6 +19,9 @@ DiscoveryServer::DiscoveryServer()
 
 	m_socket = INVALID_SOCKET;
 	m_recvBuffer.resize( 1024 );
+
+	m_batchAddrs.reserve( MAX_BATCH );
+	m_batchPayloads.reserve( MAX_BATCH * PAYLOAD_LENGTH );
 }
 
 DiscoveryServer::~DiscoveryServer()
@@ -78,34 +81,94 @@ void DiscoveryServer::Stop()
 
 void DiscoveryServer::Run()
 {
-	sockaddr_in clientAddr;
-	int clientAddrLen = sizeof( clientAddr );
-
 	while( m_running )
 	{
 		std::this_thread::sleep_for( std::chrono::milliseconds( 1 ) );
 
-		auto bytesReceived = recvfrom( m_socket, ( char * )m_recvBuffer.data(), 1024, 0, ( struct sockaddr * )&clientAddr, &clientAddrLen );
-
-		if( bytesReceived == SOCKET_ERROR || bytesReceived < 4 )
+		if( !ReceivePacket( true ) )
 		{
 			continue;
 		}
 
-		ProcessPacket( &clientAddr, std::make_shared< ByteBuffer >( m_recvBuffer.data(), bytesReceived ) );
+		// Drain whatever else is already queued on the socket so the
+		// payloads can be decrypted in one pass.
+		while( m_batchAddrs.size() < MAX_BATCH && ReceivePacket( false ) )
+		{
+		}
+
+		ProcessBatch();
 	}
 }
 
-void DiscoveryServer::ProcessPacket( sockaddr_in *clientAddr, sptr_byte_stream stream )
+bool DiscoveryServer::ReceivePacket( bool wait )
 {
-	if( 0x20 != stream->read_u32() )
+	if( !wait )
+	{
+		fd_set readSet;
+		FD_ZERO( &readSet );
+		FD_SET( m_socket, &readSet );
+
+		timeval timeout = { 0, 0 };
+		if( select( 0, &readSet, nullptr, nullptr, &timeout ) <= 0 )
+		{
+			return false;
+		}
+	}
+
+	sockaddr_in clientAddr;
+	int clientAddrLen = sizeof( clientAddr );
+
+	auto bytesReceived = recvfrom( m_socket, ( char * )m_recvBuffer.data(), 1024, 0, ( struct sockaddr * )&clientAddr, &clientAddrLen );
+
+	if( bytesReceived == SOCKET_ERROR )
+	{
+		return false;
+	}
+
+	if( bytesReceived >= 4 )
+	{
+		QueuePacket( clientAddr, std::make_shared< ByteBuffer >( m_recvBuffer.data(), bytesReceived ) );
+	}
+
+	return true;
+}
+
+void DiscoveryServer::QueuePacket( const sockaddr_in &clientAddr, sptr_byte_stream stream )
+{
+	if( PAYLOAD_LENGTH != stream->read_u32() )
 		return;
 
-	auto encryptedBytes = stream->read_bytes( 0x20 );
-	auto decryptedBytes = RealmCrypt::decryptSymmetric( encryptedBytes );
+	auto encryptedBytes = stream->read_bytes( PAYLOAD_LENGTH );
 
+	if( !stream->is_valid() )
+		return;
+
+	m_batchAddrs.push_back( clientAddr );
+	m_batchPayloads.insert( m_batchPayloads.end(), encryptedBytes.begin(), encryptedBytes.end() );
+}
+
+void DiscoveryServer::ProcessBatch()
+{
+	if( m_batchAddrs.empty() )
+	{
+		return;
+	}
+
+	RealmCrypt::decryptSymmetricBatch( m_batchPayloads );
+
+	for( size_t i = 0; i < m_batchAddrs.size(); i++ )
+	{
+		ProcessHandshake( m_batchAddrs[ i ], m_batchPayloads.data() + i * PAYLOAD_LENGTH );
+	}
+
+	m_batchAddrs.clear();
+	m_batchPayloads.clear();
+}
+
+void DiscoveryServer::ProcessHandshake( const sockaddr_in &clientAddr, const uint8_t *payload )
+{
 	std::wstring sessionId( 16, L'\0' );
-	std::memcpy( sessionId.data(), decryptedBytes.data(), 0x20 );
+	std::memcpy( sessionId.data(), payload, PAYLOAD_LENGTH );
 
 	// Validate the session ID is 16 characters long and not all 0's
 	if( sessionId.size() != 16 || std::all_of( sessionId.begin(), sessionId.end(), []( wchar_t ch )
@@ -119,9 +182,9 @@ void DiscoveryServer::ProcessPacket( sockaddr_in *clientAddr, sptr_byte_stream s
 
 	// Get the users remote IP and Port for discovery.
 	char remoteIp[ INET_ADDRSTRLEN ];
-	InetNtopA( AF_INET, &clientAddr->sin_addr, remoteIp, INET_ADDRSTRLEN );
+	InetNtopA( AF_INET, &clientAddr.sin_addr, remoteIp, INET_ADDRSTRLEN );
 
-	uint16_t remotePort = ntohs( clientAddr->sin_port );
+	uint16_t remotePort = ntohs( clientAddr.sin_port );
 
 	// Find the user associated with the session ID
 	auto user = UserManager::Get().FindUserBySessionId( sessionId );
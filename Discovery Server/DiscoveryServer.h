@@ -33,11 +33,21 @@ public:
 	}
 
 private:
-	void ProcessPacket( sockaddr_in *clientAddr, sptr_byte_stream stream );
+	// Handshakes drained from the socket per pass and decrypted together.
+	static constexpr size_t MAX_BATCH = 8;
+	static constexpr size_t PAYLOAD_LENGTH = 0x20;
+
+	bool ReceivePacket( bool wait );
+	void QueuePacket( const sockaddr_in &clientAddr, sptr_byte_stream stream );
+	void ProcessBatch();
+	void ProcessHandshake( const sockaddr_in &clientAddr, const uint8_t *payload );
 
 	std::atomic< bool > m_running;
 	std::thread m_thread;
 
 	SOCKET m_socket;
 	std::vector< unsigned char >	m_recvBuffer;
+
+	std::vector< sockaddr_in >		m_batchAddrs;
+	std::vector< uint8_t >			m_batchPayloads;
 };
\ No newline at end of file
@@ -12,6 +12,7 @@
 #include "RealmUser.h"
 #include "RealmUserManager.h"
 #include "../Database/Database.h"
+#include "../Common/Utility.h"
 #include "../../logging.h"
 
 CharacterSaveManager::CharacterSaveManager()
@@ -46,11 +47,11 @@ bool CharacterSaveManager::BeginSaveTask(
 		return false;
 	}
 
-	const auto &sessionId = m_owner->m_sessionId;
+	const auto sessionKey = m_owner->m_sessionKey;
 
-	if( m_tasks.find( sessionId ) != m_tasks.end() )
+	if( m_tasks.find( sessionKey ) != m_tasks.end() )
 	{
-		m_tasks.erase( sessionId );
+		m_tasks.erase( sessionKey );
 	}
 
 	auto task = std::make_shared< CharacterSaveTask >( saveType, characterId );
@@ -58,7 +59,7 @@ bool CharacterSaveManager::BeginSaveTask(
 	task->m_ownerUser = m_owner;
 	task->m_targetUser = m_target;
 	task->m_meta = metaData;
-	m_tasks[ sessionId ] = task;
+	m_tasks[ sessionKey ] = task;
 
 	return true;
 }
@@ -67,7 +68,7 @@ void CharacterSaveManager::AppendSaveData( const std::wstring &sessionId, const
 {
 	try
 	{
-		auto it = m_tasks.find( sessionId );
+		auto it = m_tasks.find( Util::SessionKey( sessionId ) );
 		if( it == m_tasks.end() )
 		{
 			Log::Error( "AddDataToSaveTask: No task found for session ID [{}].", sessionId );
@@ -111,7 +112,7 @@ bool CharacterSaveManager::CommitSaveTask( const std::wstring &sessionId )
 {
 	try
 	{
-		auto node = m_tasks.extract( sessionId );
+		auto node = m_tasks.extract( Util::SessionKey( sessionId ) );
 		if( !node )
 		{
 			Log::Error( "CommitSaveTask: Task for session ID [{}] not found.", sessionId );
@@ -176,7 +177,7 @@ bool CharacterSaveManager::CommitSaveTask( const std::wstring &sessionId )
 
 void CharacterSaveManager::RemoveSaveTask( const std::wstring &sessionId )
 {
-	auto it = m_tasks.find( sessionId );
+	auto it = m_tasks.find( Util::SessionKey( sessionId ) );
 	if( it != m_tasks.end() )
 	{
 		m_tasks.erase( it );
@@ -190,7 +191,7 @@ void CharacterSaveManager::RemoveSaveTask( const std::wstring &sessionId )
 
 sptr_character_save_task CharacterSaveManager::FindSaveTask( const std::wstring &sessionId )
 {
-	auto it = m_tasks.find( sessionId );
+	auto it = m_tasks.find( Util::SessionKey( sessionId ) );
 	if( it != m_tasks.end() )
 	{
 		return it->second;
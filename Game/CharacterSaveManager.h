@@ -39,5 +39,6 @@ public:
 	sptr_character_save_task FindSaveTask( const std::wstring &sessionId );
 
 public:
-	std::unordered_map< std::wstring, sptr_character_save_task > m_tasks;
+	// Keyed by the owner's session key (see Util::SessionKey).
+	std::unordered_map< uint64_t, sptr_character_save_task > m_tasks;
 };
\ No newline at end of file
@@ -2,6 +2,7 @@
 #include "GameSession.h"
 
 #include "RealmUser.h"
+#include "../Common/Utility.h"
 #include "../../logging.h"
 
 GameSession::GameSession( uint32_t index ) : m_gameId( index )
@@ -99,13 +100,15 @@ sptr_user GameSession::GetMember( int32_t index ) const
 
 sptr_user GameSession::GetMemberBySessionId( const std::wstring &sessionId ) const
 {
+	const auto sessionKey = Util::SessionKey( sessionId );
+
 	for( const auto &m : m_members )
 	{
 		if( m.expired() )
 			continue;
 
 		const auto &member = m.lock();
-		if( member->m_sessionId == sessionId )
+		if( member->m_sessionKey == sessionKey )
 		{
 			return member;
 		}
@@ -138,7 +141,7 @@ bool GameSession::AddMember( sptr_user user )
 
 		if( memberPtr )
 		{
-			if( memberPtr->m_sessionId == user->m_sessionId )
+			if( memberPtr->m_sessionKey == user->m_sessionKey )
 				return false;
 		}
 		else if( freeIndex == -1 )
@@ -11,8 +11,8 @@
 GameSessionManager::GameSessionManager()
 {
 	m_uniqueGameIndex = 0;
-	m_gameSessionList[ 0 ].clear();
-	m_gameSessionList[ 1 ].clear();
+	m_browseVersion[ 0 ] = 0;
+	m_browseVersion[ 1 ] = 0;
 }
 
 GameSessionManager::~GameSessionManager()
@@ -39,7 +39,7 @@ void GameSessionManager::OnDisconnectUser( sptr_user user )
 		return;
 	}
 
-	if( owner->m_sessionId == user->m_sessionId )
+	if( owner->m_sessionKey == user->m_sessionKey )
 	{
 		Log::Info( "Game session owner disconnected! [{}]", gameId );
 		ForceTerminateGame( gameId, gameType );
@@ -79,7 +79,7 @@ bool GameSessionManager::CreateGameSession_CON( sptr_user user,
 	new_session->AddMember( user );
 
 	std::lock_guard< std::mutex > lock( m_dataMutex );
-	m_gameSessionList[ RealmGameType::CHAMPIONS_OF_NORRATH ].push_back( new_session );
+	AddGame( new_session, RealmGameType::CHAMPIONS_OF_NORRATH );
 
 	return true;
 }
@@ -125,11 +125,102 @@ bool GameSessionManager::CreateGameSession_RTA(
 	new_session->AddMember( user );
 
 	std::lock_guard< std::mutex > lock( m_dataMutex );
-	m_gameSessionList[ RealmGameType::RETURN_TO_ARMS ].push_back( new_session );
+	AddGame( new_session, RealmGameType::RETURN_TO_ARMS );
 
 	return true;
 }
 
+void GameSessionManager::AddGame( const sptr_game_session &session, RealmGameType gameType )
+{
+	auto &index = m_games[ gameType ];
+
+	index.byId[ session->m_gameId ] = session;
+	index.byName.emplace( session->m_gameName, session );
+
+	SetBrowsable( session, gameType,
+		session->m_type == GameSession::GameType::Public && session->m_state == GameSession::GameState::Open );
+
+	m_browseVersion[ gameType ]++;
+}
+
+void GameSessionManager::RemoveGame( const sptr_game_session &session, RealmGameType gameType )
+{
+	auto &index = m_games[ gameType ];
+
+	index.byId.erase( session->m_gameId );
+	SetBrowsable( session, gameType, false );
+
+	auto [ first, last ] = index.byName.equal_range( session->m_gameName );
+	for( auto it = first; it != last; ++it )
+	{
+		if( it->second == session )
+		{
+			index.byName.erase( it );
+			break;
+		}
+	}
+
+	m_browseVersion[ gameType ]++;
+}
+
+void GameSessionManager::SetState( const sptr_game_session &session, RealmGameType gameType, GameSession::GameState state )
+{
+	session->m_state = state;
+
+	// Keep the browse set in step with the public/open state.
+	auto &index = m_games[ gameType ];
+	if( !index.byId.contains( session->m_gameId ) )
+	{
+		return;
+	}
+
+	SetBrowsable( session, gameType,
+		session->m_type == GameSession::GameType::Public && state == GameSession::GameState::Open );
+
+	m_browseVersion[ gameType ]++;
+}
+
+void GameSessionManager::SetBrowsable( const sptr_game_session &session, RealmGameType gameType, bool browsable )
+{
+	auto &browse = m_games[ gameType ].browse;
+
+	if( browsable )
+	{
+		browse[ session->m_gameId ] = session;
+	}
+	else
+	{
+		browse.erase( session->m_gameId );
+	}
+
+	if( gameType != RealmGameType::RETURN_TO_ARMS )
+	{
+		return;
+	}
+
+	if( browsable )
+	{
+		m_matchmaking.Insert( session );
+	}
+	else
+	{
+		m_matchmaking.Remove( session );
+	}
+}
+
+void GameSessionManager::OnGameUpdated( const sptr_game_session &session, RealmGameType gameType )
+{
+	if( session == nullptr )
+		return;
+
+	std::lock_guard< std::mutex > lock( m_dataMutex );
+
+	if( m_games[ gameType ].browse.contains( session->m_gameId ) )
+	{
+		m_browseVersion[ gameType ]++;
+	}
+}
+
 bool GameSessionManager::ForceTerminateGame( int32_t gameId, RealmGameType clientType )
 {
 	if( gameId < 0 )
@@ -139,15 +230,12 @@ bool GameSessionManager::ForceTerminateGame( int32_t gameId, RealmGameType clien
 
 	std::lock_guard< std::mutex > lock( m_dataMutex );
 
-	const auto &gameList = m_gameSessionList[ clientType ];
-	const auto it = std::find_if( gameList.begin(), gameList.end(), [ &gameId ]( sptr_game_session gameSession )
-	{
-		return gameSession->m_gameId == gameId;
-	} );
+	const auto &games = m_games[ clientType ].byId;
+	const auto it = games.find( gameId );
 
-	if( it != m_gameSessionList[ clientType ].end() )
+	if( it != games.end() )
 	{
-		m_gameSessionList[ clientType ].erase( it );
+		RemoveGame( sptr_game_session( it->second ), clientType );
 		return true;
 	}
 
@@ -160,15 +248,10 @@ sptr_game_session GameSessionManager::FindGame( const int32_t gameId, const Real
 
 	std::lock_guard< std::mutex > lock( m_dataMutex );
 
-	for( auto &gameSession : m_gameSessionList[ gameType ] )
-	{
-		if( gameSession->m_gameId == gameId )
-		{
-			return gameSession;
-		}
-	}
+	const auto &games = m_games[ gameType ].byId;
+	const auto it = games.find( gameId );
 
-	return nullptr;
+	return ( it != games.end() ) ? it->second : nullptr;
 }
 
 sptr_game_session GameSessionManager::FindGame( const std::wstring &gameName, const RealmGameType gameType )
@@ -177,15 +260,18 @@ sptr_game_session GameSessionManager::FindGame( const std::wstring &gameName, co
 
 	std::lock_guard< std::mutex > lock( m_dataMutex );
 
-	for( auto &gameSession : m_gameSessionList[ gameType ] )
+	sptr_game_session result;
+
+	auto [ first, last ] = m_games[ gameType ].byName.equal_range( gameName );
+	for( auto it = first; it != last; ++it )
 	{
-		if( gameSession->m_gameName == gameName )
+		if( !result || it->second->m_gameId < result->m_gameId )
 		{
-			return gameSession;
+			result = it->second;
 		}
 	}
 
-	return nullptr;
+	return result;
 }
 
 bool GameSessionManager::RequestOpen( sptr_user user )
@@ -217,7 +303,10 @@ bool GameSessionManager::RequestOpen( sptr_user user )
 	session->m_hostExternalAddr = user->m_discoveryAddr;
 	session->m_hostNatPort = user->m_discoveryPort;
 
-	session->m_state = GameSession::GameState::Open;
+	{
+		std::lock_guard< std::mutex > lock( m_dataMutex );
+		SetState( session, gameType, GameSession::GameState::Open );
+	}
 
 	// Tell the host its own address.
 	user->sock->send( NotifyGameDiscovered( user ) );
@@ -236,18 +325,13 @@ bool GameSessionManager::RequestCancel( sptr_user user )
 
 	const auto gameId = user->m_gameId;
 	const auto gameType = user->m_gameType;
-	auto &gameList = m_gameSessionList[ gameType ];
-
-	const auto it = std::find_if( gameList.begin(), gameList.end(),
-								  [ gameId ]( const sptr_game_session &gameSession )
-	{
-		return gameSession->m_gameId == gameId;
-	} );
+	const auto &games = m_games[ gameType ].byId;
 
-	if( it == gameList.end() )
+	const auto it = games.find( gameId );
+	if( it == games.end() )
 		return false;
 
-	const auto &session = *it;
+	const auto session = it->second;
 
 	if( false == session->RemoveMember( user ) )
 	{
@@ -257,10 +341,13 @@ bool GameSessionManager::RequestCancel( sptr_user user )
 	if( session->m_currentPlayers <= 0 )
 	{
 		Log::Info( "Game session [{}] is empty, removing it", gameId );
-		gameList.erase( it );
+		RemoveGame( session, gameType );
 	}
 	else
 	{
+		// The player count feeds browse ranking.
+		m_browseVersion[ gameType ]++;
+
 		Log::Info( "User [{}] left game session [{}], remaining players: {}",
 				   user->m_username, gameId, session->m_currentPlayers );
 	}
@@ -334,21 +421,10 @@ bool GameSessionManager::RequestStart( sptr_user user )
 
 	std::lock_guard<std::mutex> lock( m_dataMutex );
 
-	session->m_state = GameSession::GameState::Started;
+	SetState( session, gameType, GameSession::GameState::Started );
 
 	// Remove the game from the list.
-	auto &gameList = m_gameSessionList[ gameType ];
-
-	const auto it = std::find_if( gameList.begin(), gameList.end(),
-								  [ gameId ]( const sptr_game_session &gameSession )
-	{
-		return gameSession->m_gameId == gameId;
-	} );
-
-	if( it != gameList.end() )
-	{
-		gameList.erase( it );
-	}
+	RemoveGame( session, gameType );
 
 	Log::Info( "Game session [{}] started", gameId );
 
@@ -356,27 +432,49 @@ bool GameSessionManager::RequestStart( sptr_user user )
 }
 
 std::vector<sptr_game_session> GameSessionManager::GetAvailableGameSessionList( const RealmGameType gameType ) const
+{
+	uint64_t version;
+	return GetAvailableGameSessionList( gameType, version );
+}
+
+std::vector<sptr_game_session> GameSessionManager::GetAvailableGameSessionList( const RealmGameType gameType, uint64_t &version ) const
 {
 	std::lock_guard<std::mutex> lock( m_dataMutex );
 
+	version = m_browseVersion[ gameType ];
+
+	const auto &browse = m_games[ gameType ].browse;
+
 	std::vector<sptr_game_session> list;
-	for( const auto &game : m_gameSessionList[ gameType ] )
+	list.reserve( browse.size() );
+
+	for( const auto &[ gameId, game ] : browse )
 	{
-		if( game->m_type == GameSession::GameType::Public &&
-			game->m_state == GameSession::GameState::Open )
-		{
-			list.push_back( game );
-		}
+		list.push_back( game );
 	}
 	return list;
 }
 
+uint64_t GameSessionManager::GetBrowseVersion( const RealmGameType gameType ) const
+{
+	std::lock_guard<std::mutex> lock( m_dataMutex );
+	return m_browseVersion[ gameType ];
+}
+
+std::vector<sptr_game_session> GameSessionManager::FindMatchingGames( const MatchmakingIndex::Query &query, uint64_t &version ) const
+{
+	std::lock_guard<std::mutex> lock( m_dataMutex );
+
+	version = m_browseVersion[ RealmGameType::RETURN_TO_ARMS ];
+	return m_matchmaking.Find( query );
+}
+
 std::vector<sptr_game_session> GameSessionManager::GetPublicGameSessionList( const RealmGameType gameType ) const
 {
 	std::lock_guard<std::mutex> lock( m_dataMutex );
 
 	std::vector<sptr_game_session> list;
-	for( const auto &game : m_gameSessionList[ gameType ] )
+	for( const auto &[ gameId, game ] : m_games[ gameType ].byId )
 	{
 		if( game->m_type == GameSession::GameType::Public )
 			list.push_back( game );
@@ -389,7 +487,7 @@ std::vector<sptr_game_session> GameSessionManager::GetPrivateGameSessionList( co
 	std::lock_guard<std::mutex> lock( m_dataMutex );
 
 	std::vector<sptr_game_session> list;
-	for( const auto &game : m_gameSessionList[ gameType ] )
+	for( const auto &[ gameId, game ] : m_games[ gameType ].byId )
 	{
 		if( game->m_type == GameSession::GameType::Private )
 			list.push_back( game );
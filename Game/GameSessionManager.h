@@ -1,10 +1,13 @@
 #pragma once
 
+#include <map>
 #include <memory>
 #include <mutex>
+#include <unordered_map>
 #include <vector>
 
 #include "GameSession.h"
+#include "MatchmakingIndex.h"
 
 #include "../Common/Constant.h"
 
@@ -14,8 +17,25 @@ private:
 	static inline std::mutex m_mutex;
 	static inline std::mutex m_dataMutex;
 
+	// Per game type. Names are not unique for Champions of Norrath, so the
+	// name index is a multimap and lookups prefer the oldest game. The
+	// browse set holds only public, open games, keyed by ID so browses
+	// list them in creation order.
+	struct GameIndex {
+		std::unordered_map< int32_t, sptr_game_session > byId;
+		std::unordered_multimap< std::wstring, sptr_game_session > byName;
+		std::map< int32_t, sptr_game_session > browse;
+	};
+
 	int32_t m_uniqueGameIndex;
-	std::vector< sptr_game_session > m_gameSessionList[ 2 ];
+	GameIndex m_games[ 2 ];
+
+	// Bumped whenever anything a browse result encodes changes, so cached
+	// encodings of the list know when they are stale.
+	uint64_t m_browseVersion[ 2 ];
+
+	// Mirrors the Return to Arms browse set.
+	MatchmakingIndex m_matchmaking;
 
 public:
 	GameSessionManager();
@@ -57,11 +77,26 @@ public:
 	bool RequestJoin( sptr_user user );
 	bool RequestStart( sptr_user user );
 
+	// Call after changing the listed fields of a game outside the manager.
+	void OnGameUpdated( const sptr_game_session &session, RealmGameType gameType );
+
 	std::vector< sptr_game_session > GetAvailableGameSessionList( const RealmGameType clientType ) const;
+	std::vector< sptr_game_session > GetAvailableGameSessionList( const RealmGameType clientType, uint64_t &version ) const;
+	uint64_t GetBrowseVersion( const RealmGameType clientType ) const;
+
+	// Open public Return to Arms games matching the query, with the browse
+	// version they were read at.
+	std::vector< sptr_game_session > FindMatchingGames( const MatchmakingIndex::Query &query, uint64_t &version ) const;
 	std::vector< sptr_game_session > GetPublicGameSessionList( const RealmGameType clientType ) const;
 	std::vector< sptr_game_session > GetPrivateGameSessionList( const RealmGameType clientType ) const;
 
 private:
+	// These expect m_dataMutex to be held.
+	void AddGame( const sptr_game_session &session, RealmGameType gameType );
+	void RemoveGame( const sptr_game_session &session, RealmGameType gameType );
+	void SetState( const sptr_game_session &session, RealmGameType gameType, GameSession::GameState state );
+	void SetBrowsable( const sptr_game_session &session, RealmGameType gameType, bool browsable );
+
 	void ProcessJoinNorrath( sptr_user join, sptr_user host );
 	void ProcessJoinArms( sptr_user join, sptr_user host );
 };
\ No newline at end of file
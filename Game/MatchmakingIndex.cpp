@@ -0,0 +1,185 @@
+#include "MatchmakingIndex.h"
+
+#include <algorithm>
+#include <bit>
+
+#if defined( _M_X64 ) || defined( __x86_64__ ) || ( defined( _M_IX86_FP ) && _M_IX86_FP >= 2 ) || defined( __SSE2__ )
+#define MATCH_SSE2
+#include <emmintrin.h>
+#endif
+
+// dst &= src, treating words past the end of src as zero.
+static void AndInto( std::vector< uint64_t > &dst, const std::vector< uint64_t > &src )
+{
+	const size_t words = std::min( dst.size(), src.size() );
+	size_t i = 0;
+
+#ifdef MATCH_SSE2
+	for( ; i + 2 <= words; i += 2 )
+	{
+		const auto a = _mm_loadu_si128( reinterpret_cast< const __m128i * >( dst.data() + i ) );
+		const auto b = _mm_loadu_si128( reinterpret_cast< const __m128i * >( src.data() + i ) );
+		_mm_storeu_si128( reinterpret_cast< __m128i * >( dst.data() + i ), _mm_and_si128( a, b ) );
+	}
+#endif
+
+	for( ; i < words; i++ )
+	{
+		dst[ i ] &= src[ i ];
+	}
+
+	std::fill( dst.begin() + words, dst.end(), 0 );
+}
+
+MatchmakingIndex::AttributeValues MatchmakingIndex::GetAttributes( const GameSession &session )
+{
+	return { session.m_difficulty, session.m_gameMode, session.m_mission, session.m_networkSave };
+}
+
+void MatchmakingIndex::SetBit( Bitmap &bitmap, uint32_t slot )
+{
+	const size_t word = slot / 64;
+	if( word >= bitmap.size() )
+	{
+		bitmap.resize( word + 1, 0 );
+	}
+
+	bitmap[ word ] |= 1ull << ( slot % 64 );
+}
+
+void MatchmakingIndex::ClearBit( Bitmap &bitmap, uint32_t slot )
+{
+	const size_t word = slot / 64;
+	if( word < bitmap.size() )
+	{
+		bitmap[ word ] &= ~( 1ull << ( slot % 64 ) );
+	}
+}
+
+void MatchmakingIndex::Insert( const sptr_game_session &session )
+{
+	if( session == nullptr || m_slotById.contains( session->m_gameId ) )
+	{
+		return;
+	}
+
+	uint32_t slot;
+	if( !m_freeSlots.empty() )
+	{
+		slot = m_freeSlots.back();
+		m_freeSlots.pop_back();
+	}
+	else
+	{
+		slot = static_cast< uint32_t >( m_slots.size() );
+		m_slots.emplace_back();
+		m_slotAttributes.emplace_back();
+	}
+
+	const auto attributes = GetAttributes( *session );
+
+	m_slots[ slot ] = session;
+	m_slotAttributes[ slot ] = attributes;
+	m_slotById[ session->m_gameId ] = slot;
+
+	SetBit( m_live, slot );
+	for( size_t i = 0; i < attributes.size(); i++ )
+	{
+		SetBit( Posting( i, attributes[ i ] ), slot );
+	}
+}
+
+void MatchmakingIndex::Remove( const sptr_game_session &session )
+{
+	if( session == nullptr )
+	{
+		return;
+	}
+
+	const auto it = m_slotById.find( session->m_gameId );
+	if( it == m_slotById.end() )
+	{
+		return;
+	}
+
+	const auto slot = it->second;
+	m_slotById.erase( it );
+
+	// Clear with the values recorded at insert in case the session changed.
+	const auto &attributes = m_slotAttributes[ slot ];
+
+	ClearBit( m_live, slot );
+	for( size_t i = 0; i < attributes.size(); i++ )
+	{
+		ClearBit( Posting( i, attributes[ i ] ), slot );
+	}
+
+	m_slots[ slot ].reset();
+	m_freeSlots.push_back( slot );
+}
+
+std::vector< sptr_game_session > MatchmakingIndex::Find( const Query &query ) const
+{
+	Bitmap matches = m_live;
+
+	for( size_t i = 0; i < query.attributes.size(); i++ )
+	{
+		if( query.attributes[ i ].has_value() )
+		{
+			AndInto( matches, Posting( i, *query.attributes[ i ] ) );
+		}
+	}
+
+	std::vector< sptr_game_session > result;
+
+	for( size_t word = 0; word < matches.size(); word++ )
+	{
+		for( auto bits = matches[ word ]; bits != 0; bits &= bits - 1 )
+		{
+			const auto slot = word * 64 + std::countr_zero( bits );
+			const auto &session = m_slots[ slot ];
+
+			if( query.openSlotsOnly && session->m_currentPlayers >= session->m_maximumPlayers )
+			{
+				continue;
+			}
+
+			result.push_back( session );
+		}
+	}
+
+	// Game IDs are handed out in creation order, so a lower ID is older.
+	const auto byAge = []( const sptr_game_session &a, const sptr_game_session &b )
+	{
+		return a->m_gameId < b->m_gameId;
+	};
+
+	const auto byFill = []( const sptr_game_session &a, const sptr_game_session &b )
+	{
+		// a is fuller than b when a.current / a.max > b.current / b.max.
+		const int32_t lhs = a->m_currentPlayers * std::max< int32_t >( b->m_maximumPlayers, 1 );
+		const int32_t rhs = b->m_currentPlayers * std::max< int32_t >( a->m_maximumPlayers, 1 );
+
+		if( lhs != rhs )
+		{
+			return lhs > rhs;
+		}
+
+		return a->m_gameId < b->m_gameId;
+	};
+
+	const auto count = ( query.limit != 0 ) ? std::min( query.limit, result.size() ) : result.size();
+
+	if( query.order == Order::Fill )
+	{
+		std::partial_sort( result.begin(), result.begin() + count, result.end(), byFill );
+	}
+	else
+	{
+		std::partial_sort( result.begin(), result.begin() + count, result.end(), byAge );
+	}
+
+	result.resize( count );
+
+	return result;
+}
\ No newline at end of file
@@ -0,0 +1,74 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <unordered_map>
+#include <vector>
+
+#include "GameSession.h"
+
+// Attribute index over open Return to Arms games. Every indexed game owns a
+// dense slot, and each attribute value keeps a bitmap of the slots that
+// carry it, so a filtered query is an AND of a few bitmaps followed by a
+// walk over the surviving bits.
+class MatchmakingIndex
+{
+public:
+	enum class Attribute {
+		Difficulty,
+		GameMode,
+		Mission,
+		NetworkSave,
+		Count
+	};
+
+	enum class Order {
+		Age,	// Oldest first.
+		Fill	// Fullest first, then oldest.
+	};
+
+	struct Query {
+		std::array< std::optional< int8_t >, static_cast< size_t >( Attribute::Count ) > attributes;
+		bool openSlotsOnly = true;
+		Order order = Order::Fill;
+		size_t limit = 0;	// 0 returns every match.
+	};
+
+	void Insert( const sptr_game_session &session );
+	void Remove( const sptr_game_session &session );
+
+	std::vector< sptr_game_session > Find( const Query &query ) const;
+
+	size_t Size() const
+	{
+		return m_slotById.size();
+	}
+
+private:
+	using Bitmap = std::vector< uint64_t >;
+	using AttributeValues = std::array< int8_t, static_cast< size_t >( Attribute::Count ) >;
+
+	static AttributeValues GetAttributes( const GameSession &session );
+	static void SetBit( Bitmap &bitmap, uint32_t slot );
+	static void ClearBit( Bitmap &bitmap, uint32_t slot );
+
+	Bitmap &Posting( size_t attribute, int8_t value )
+	{
+		return m_postings[ attribute ][ static_cast< uint8_t >( value ) ];
+	}
+
+	const Bitmap &Posting( size_t attribute, int8_t value ) const
+	{
+		return m_postings[ attribute ][ static_cast< uint8_t >( value ) ];
+	}
+
+	std::vector< sptr_game_session > m_slots;
+	std::vector< AttributeValues > m_slotAttributes;
+	std::vector< uint32_t > m_freeSlots;
+	std::unordered_map< int32_t, uint32_t > m_slotById;
+
+	Bitmap m_live;
+	std::array< std::array< Bitmap, 256 >, static_cast< size_t >( Attribute::Count ) > m_postings;
+};
\ No newline at end of file
@@ -1,6 +1,8 @@
 #include "RealmUser.h"
 #include "RealmCharacter.h"
 
+#include "../Common/Utility.h"
+
 RealmUser::RealmUser()
 {
 	sock = nullptr;
@@ -9,7 +11,10 @@ RealmUser::RealmUser()
 
 	m_accountId = -1;
 	m_sessionId = L"";
+	m_sessionKey = 0;
 	m_username = L"";
+	m_usernameId = StringInterner::INVALID_ID;
+	m_chatHandleId = StringInterner::INVALID_ID;
 	m_characterId = 0;
 
 	m_localAddr = "";
@@ -23,6 +28,103 @@ RealmUser::RealmUser()
 	m_privateRoomId = -1;
 }
 
+bool RealmUser::SetSessionId( const std::wstring &sessionId )
+{
+	const auto sessionKey = Util::SessionKey( sessionId );
+	if( sessionKey == 0 )
+	{
+		return false;
+	}
+
+	m_sessionId = sessionId;
+	m_sessionKey = sessionKey;
+	m_sessionCipher = RealmCrypt::cacheString( sessionId );
+
+	if( sock )
+	{
+		sock->session_cipher = m_sessionCipher;
+	}
+
+	return true;
+}
+
+void RealmUser::SetIdentity( const std::wstring &username, const std::wstring &chatHandle )
+{
+	auto &interner = StringInterner::Get();
+
+	m_username = username;
+	m_usernameId = username.empty() ? StringInterner::INVALID_ID : interner.Intern( username );
+
+	m_chatHandle = chatHandle;
+	m_chatHandleId = chatHandle.empty() ? StringInterner::INVALID_ID : interner.Intern( chatHandle );
+}
+
+void RealmUser::SetFriendList( std::vector< std::wstring > handles )
+{
+	m_friendList = std::move( handles );
+	m_friendSet.Clear();
+
+	for( const auto &handle : m_friendList )
+	{
+		m_friendSet.Insert( StringInterner::Get().Intern( handle ) );
+	}
+}
+
+void RealmUser::SetIgnoreList( std::vector< std::wstring > handles )
+{
+	m_ignoreList = std::move( handles );
+	m_ignoreSet.Clear();
+
+	for( const auto &handle : m_ignoreList )
+	{
+		m_ignoreSet.Insert( StringInterner::Get().Intern( handle ) );
+	}
+}
+
+bool RealmUser::AddFriend( const std::wstring &handle )
+{
+	if( !m_friendSet.Insert( StringInterner::Get().Intern( handle ) ) )
+	{
+		return false;
+	}
+
+	m_friendList.push_back( handle );
+	return true;
+}
+
+bool RealmUser::RemoveFriend( const std::wstring &handle )
+{
+	if( !m_friendSet.Erase( StringInterner::Get().Find( handle ) ) )
+	{
+		return false;
+	}
+
+	std::erase( m_friendList, handle );
+	return true;
+}
+
+bool RealmUser::AddIgnore( const std::wstring &handle )
+{
+	if( !m_ignoreSet.Insert( StringInterner::Get().Intern( handle ) ) )
+	{
+		return false;
+	}
+
+	m_ignoreList.push_back( handle );
+	return true;
+}
+
+bool RealmUser::RemoveIgnore( const std::wstring &handle )
+{
+	if( !m_ignoreSet.Erase( StringInterner::Get().Find( handle ) ) )
+	{
+		return false;
+	}
+
+	std::erase( m_ignoreList, handle );
+	return true;
+}
+
 RealmUser::~RealmUser()
 {
 	if( sock )
@@ -7,6 +7,8 @@
 #include "RealmCharacter.h"
 
 #include "../Common/Constant.h"
+#include "../Common/HandleSet.h"
+#include "../Common/StringInterner.h"
 #include "../Network/RealmSocket.h"
 
 class RealmUser {
@@ -26,24 +28,47 @@ public:
 		return m_accountId < other.m_accountId;
 	}
 
+	// Returns false, leaving the session untouched, if the ID is not a
+	// valid session key (GenerateSessionId failed).
+	bool SetSessionId( const std::wstring &sessionId );
+	void SetIdentity( const std::wstring &username, const std::wstring &chatHandle );
+
 	bool IsFriend( const std::wstring &handle ) const
 	{
-		return std::find( m_friendList.begin(), m_friendList.end(), handle ) != m_friendList.end();
+		return m_friendSet.Contains( StringInterner::Get().Find( handle ) );
 	}
 
 	bool IsIgnored( const std::wstring &handle ) const
 	{
-		return std::find( m_ignoreList.begin(), m_ignoreList.end(), handle ) != m_ignoreList.end();
+		return m_ignoreSet.Contains( StringInterner::Get().Find( handle ) );
+	}
+
+	bool IsIgnored( uint32_t handleId ) const
+	{
+		return m_ignoreSet.Contains( handleId );
 	}
 
+	// The lists below are kept in order for serialization; these keep the
+	// lookup sets in step with them.
+	void SetFriendList( std::vector< std::wstring > handles );
+	void SetIgnoreList( std::vector< std::wstring > handles );
+	bool AddFriend( const std::wstring &handle );
+	bool RemoveFriend( const std::wstring &handle );
+	bool AddIgnore( const std::wstring &handle );
+	bool RemoveIgnore( const std::wstring &handle );
+
 public:
 	sptr_socket		sock;				// For Realm Lobby
 
 	RealmGameType	m_gameType;			// Champions of Norrath or Return to Arms
 	int64_t			m_accountId;		// Unique ID of the account
 	std::wstring	m_sessionId;		// Temporary Session ID
+	uint64_t		m_sessionKey;		// m_sessionId as an integer key
+	CachedCipherText m_sessionCipher;	// Session ID in its encrypted wire form
 	std::wstring	m_username;			// Username of the user
 	std::wstring	m_chatHandle;		// Chat handle for the user, used in chat rooms
+	uint32_t		m_usernameId;		// Interned m_username
+	uint32_t		m_chatHandleId;		// Interned m_chatHandle
 
 	bool			m_isLoggedIn;		// True if the user has successfully authenticated and logged in
 	bool			m_isHost;			// True if this user is the host of a realm
@@ -62,6 +87,10 @@ public:
 
 	std::vector< std::wstring > m_friendList;	// List of friends for this user
 	std::vector< std::wstring > m_ignoreList;	// List of ignored users
+
+private:
+	HandleSet m_friendSet;						// Interned IDs of m_friendList
+	HandleSet m_ignoreSet;						// Interned IDs of m_ignoreList
 };
 
 using sptr_user = std::shared_ptr< RealmUser >;
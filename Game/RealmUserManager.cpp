@@ -1,18 +1,17 @@
 #include "RealmUserManager.h"
 #include "GameSessionManager.h"
 #include "ChatRoomManager.h"
+#include "SessionTokenService.h"
 
 #include "../Network/Event/NotifyForcedLogout.h"
 #include "../Network/Event/NotifyFriendStatus.h"
 #include "../Database/Database.h"
 #include "../Common/Constant.h"
+#include "../Common/StringInterner.h"
 #include "../logging.h"
 
 UserManager::UserManager()
 {
-	std::random_device rd;
-	rng.seed( rd() );
-
 	m_users.clear();
 }
 
@@ -20,20 +19,9 @@ UserManager::~UserManager()
 {
 }
 
-std::wstring UserManager::GenerateSessionId()
+std::wstring UserManager::GenerateSessionId( const sptr_user &user )
 {
-	static const wchar_t charset[] = L"0123456789ABCDEF";
-	std::uniform_int_distribution<int> dist( 0, 15 );
-
-	std::wstring sessionId;
-	sessionId.reserve( MAX_SESSION_ID_LENGTH );
-
-	for( int i = 0; i < MAX_SESSION_ID_LENGTH; ++i )
-	{
-		sessionId += charset[ dist( rng ) ];
-	}
-
-	return sessionId;
+	return SessionTokenService::Get().Issue( user );
 }
 
 sptr_user UserManager::CreateUser( sptr_socket socket, RealmGameType clientType )
@@ -44,22 +32,152 @@ sptr_user UserManager::CreateUser( sptr_socket socket, RealmGameType clientType
 
 	user->sock = socket;
 	user->m_gameType = clientType;
+	socket->user = user;
 
 	std::lock_guard< std::mutex > lock( m_mutex );
+	m_entries[ user.get() ] = { m_users.size(), StringInterner::INVALID_ID, StringInterner::INVALID_ID, -1, {} };
 	m_users.push_back( user );
 
 	return user;
 }
 
-void UserManager::RemoveUser( sptr_user user )
+void UserManager::BindUser( const sptr_user &user )
+{
+	std::lock_guard< std::mutex > lock( m_mutex );
+
+	auto it = m_entries.find( user.get() );
+	if( it == m_entries.end() )
+	{
+		return;
+	}
+
+	auto &entry = it->second;
+	UnbindKeys( user, entry );
+
+	entry.usernameId = user->m_usernameId;
+	entry.chatHandleId = user->m_chatHandleId;
+	entry.accountId = user->m_accountId;
+
+	entry.watching.clear();
+	for( const auto &handle : user->m_friendList )
+	{
+		entry.watching.push_back( StringInterner::Get().Intern( handle ) );
+	}
+
+	if( entry.usernameId != StringInterner::INVALID_ID )
+	{
+		m_byUsername[ entry.usernameId ] = user;
+	}
+
+	if( entry.chatHandleId != StringInterner::INVALID_ID )
+	{
+		m_byChatHandle[ entry.chatHandleId ] = user;
+	}
+
+	if( entry.accountId >= 0 )
+	{
+		m_byAccountId[ entry.accountId ] = user;
+	}
+
+	for( const auto handleId : entry.watching )
+	{
+		m_watchers[ handleId ].insert( user );
+	}
+}
+
+void UserManager::WatchFriend( const sptr_user &user, const std::wstring &handle )
 {
-	auto it = std::find( m_users.begin(), m_users.end(), user );
-	if( it == m_users.end() )
+	std::lock_guard< std::mutex > lock( m_mutex );
+
+	auto it = m_entries.find( user.get() );
+	if( it == m_entries.end() )
+	{
+		return;
+	}
+
+	const auto handleId = StringInterner::Get().Intern( handle );
+
+	it->second.watching.push_back( handleId );
+	m_watchers[ handleId ].insert( user );
+}
+
+void UserManager::UnwatchFriend( const sptr_user &user, const std::wstring &handle )
+{
+	std::lock_guard< std::mutex > lock( m_mutex );
+
+	auto it = m_entries.find( user.get() );
+	if( it == m_entries.end() )
 	{
-		Log::Error( "RemoveUser : [{}] not found", user->m_sessionId );
 		return;
 	}
 
+	const auto handleId = StringInterner::Get().Find( handle );
+
+	auto &watching = it->second.watching;
+	auto handleIt = std::find( watching.begin(), watching.end(), handleId );
+	if( handleIt == watching.end() )
+	{
+		return;
+	}
+
+	watching.erase( handleIt );
+
+	auto watchIt = m_watchers.find( handleId );
+	if( watchIt != m_watchers.end() )
+	{
+		watchIt->second.erase( user );
+		if( watchIt->second.empty() )
+		{
+			m_watchers.erase( watchIt );
+		}
+	}
+}
+
+void UserManager::UnbindKeys( const sptr_user &user, IndexEntry &entry )
+{
+	// Only drop a key if it still points at this user.
+	auto eraseIf = [ &user ]( auto &index, const auto &key )
+	{
+		auto it = index.find( key );
+		if( it != index.end() && it->second == user )
+		{
+			index.erase( it );
+		}
+	};
+
+	eraseIf( m_byUsername, entry.usernameId );
+	eraseIf( m_byChatHandle, entry.chatHandleId );
+	eraseIf( m_byAccountId, entry.accountId );
+
+	for( const auto handleId : entry.watching )
+	{
+		auto it = m_watchers.find( handleId );
+		if( it == m_watchers.end() )
+		{
+			continue;
+		}
+
+		it->second.erase( user );
+		if( it->second.empty() )
+		{
+			m_watchers.erase( it );
+		}
+	}
+
+	entry.watching.clear();
+}
+
+void UserManager::RemoveUser( sptr_user user )
+{
+	{
+		std::lock_guard< std::mutex > lock( m_mutex );
+		if( !m_entries.contains( user.get() ) )
+		{
+			Log::Error( "RemoveUser : [{}] not found", user->m_sessionId );
+			return;
+		}
+	}
+
 	GameSessionManager::Get().OnDisconnectUser( user );
 	ChatRoomManager::Get().OnDisconnectUser( user );
 
@@ -68,7 +186,31 @@ void UserManager::RemoveUser( sptr_user user )
 	Log::Debug( "RemoveUser : [{}][{}]", user->m_username, user->m_sessionId );
 
 	std::lock_guard< std::mutex > lock( m_mutex );
-	m_users.erase( it );
+
+	auto it = m_entries.find( user.get() );
+	if( it == m_entries.end() )
+	{
+		return;
+	}
+
+	UnbindKeys( user, it->second );
+	SessionTokenService::Get().Revoke( user );
+
+	if( user->sock && user->sock->user.lock() == user )
+	{
+		user->sock->user.reset();
+	}
+
+	// Swap the last user into the freed slot.
+	const auto slot = it->second.slot;
+	if( slot != m_users.size() - 1 )
+	{
+		m_users[ slot ] = std::move( m_users.back() );
+		m_entries[ m_users[ slot ].get() ].slot = slot;
+	}
+
+	m_users.pop_back();
+	m_entries.erase( it );
 }
 
 void UserManager::RemoveUser( const std::wstring &sessionId )
@@ -122,59 +264,75 @@ void UserManager::Disconnect( sptr_user user, const std::string reason )
 
 sptr_user UserManager::FindUserBySessionId( const std::wstring &sessionId )
 {
-	std::lock_guard<std::mutex> lock( m_mutex );
-	auto it = std::find_if( m_users.begin(), m_users.end(), [ & ]( const sptr_user &user )
-	{
-		return user->m_sessionId == sessionId;
-	} );
-	return ( it != m_users.end() ) ? *it : nullptr;
+	return SessionTokenService::Get().Resolve( sessionId );
 }
 
 sptr_user UserManager::FindUserBySocket( const sptr_socket &socket )
 {
-	std::lock_guard<std::mutex> lock( m_mutex );
-	auto it = std::find_if( m_users.begin(), m_users.end(), [ & ]( const sptr_user &user )
-	{
-		return user->sock == socket;
-	} );
-	return ( it != m_users.end() ) ? *it : nullptr;
+	return socket ? socket->user.lock() : nullptr;
 }
 
 sptr_user UserManager::FindUserByChatHandle( const std::wstring &handle )
+{
+	return FindUserByChatHandle( StringInterner::Get().Find( handle ) );
+}
+
+sptr_user UserManager::FindUserByChatHandle( uint32_t handleId )
 {
 	std::lock_guard<std::mutex> lock( m_mutex );
-	auto it = std::find_if( m_users.begin(), m_users.end(), [ & ]( const sptr_user &user )
-	{
-		return user->m_chatHandle == handle;
-	} );
-	return ( it != m_users.end() ) ? *it : nullptr;
+	auto it = m_byChatHandle.find( handleId );
+	return ( it != m_byChatHandle.end() ) ? it->second : nullptr;
 }
 
-int32_t UserManager::GetUserCount() const
+sptr_user UserManager::FindUserByAccountId( int64_t accountId )
 {
-	return static_cast< int32_t >( m_users.size() );
+	std::lock_guard<std::mutex> lock( m_mutex );
+	auto it = m_byAccountId.find( accountId );
+	return ( it != m_byAccountId.end() ) ? it->second : nullptr;
 }
 
-std::vector<sptr_user> UserManager::GetUserList()
+sptr_user UserManager::FindUserByUsername( const std::wstring &username )
 {
+	const auto usernameId = StringInterner::Get().Find( username );
+
 	std::lock_guard<std::mutex> lock( m_mutex );
-	return m_users;
+	auto it = m_byUsername.find( usernameId );
+	return ( it != m_byUsername.end() ) ? it->second : nullptr;
+}
+
+int32_t UserManager::GetUserCount() const
+{
+	return static_cast< int32_t >( m_users.size() );
 }
 
 void UserManager::NotifyFriendsOnlineStatus( const sptr_user &user, bool onlineStatus )
 {
-	if( !user || user->m_friendList.empty() )
+	if( !user || user->m_chatHandleId == StringInterner::INVALID_ID )
 	{
 		return;
 	}
 
+	// Notify everyone online who lists this user as a friend, whether or
+	// not the user lists them back.
+	std::vector< sptr_user > watchers;
+	{
+		std::lock_guard< std::mutex > lock( m_mutex );
+
+		auto it = m_watchers.find( user->m_chatHandleId );
+		if( it == m_watchers.end() )
+		{
+			return;
+		}
+
+		watchers.assign( it->second.begin(), it->second.end() );
+	}
+
 	const auto notifyFriend = NotifyFriendStatus( user->m_chatHandle, onlineStatus );
-	for( const auto &friendHandle : user->m_friendList )
+	for( const auto &watcher : watchers )
 	{
-		auto friendUser = FindUserByChatHandle( friendHandle );
-		if( friendUser && friendUser->sock )
+		if( watcher->sock )
 		{
-			friendUser->sock->send( notifyFriend );
+			watcher->sock->send( notifyFriend );
 		}
 	}
 }
@@ -4,7 +4,8 @@
 #include <mutex>
 #include <vector>
 #include <string>
-#include <random>
+#include <unordered_map>
+#include <unordered_set>
 
 #include "RealmUser.h"
 
@@ -23,8 +24,12 @@ public:
 	UserManager();
 	~UserManager();
 
-	std::wstring GenerateSessionId();
+	// Returns an empty string if no session slot is free.
+	std::wstring GenerateSessionId( const sptr_user &user );
 	sptr_user CreateUser( sptr_socket socket, RealmGameType clientType );
+	void BindUser( const sptr_user &user );
+	void WatchFriend( const sptr_user &user, const std::wstring &handle );
+	void UnwatchFriend( const sptr_user &user, const std::wstring &handle );
 	void RemoveUser( sptr_user user );
 	void RemoveUser( const std::wstring &sessionId );
 	void RemoveUser( const sptr_socket socket );
@@ -34,13 +39,33 @@ public:
 	sptr_user FindUserBySessionId( const std::wstring &sessionId );
 	sptr_user FindUserBySocket( const sptr_socket &socket );
 	sptr_user FindUserByChatHandle( const std::wstring &handle );
+	sptr_user FindUserByChatHandle( uint32_t handleId );
+	sptr_user FindUserByAccountId( int64_t accountId );
+	sptr_user FindUserByUsername( const std::wstring &username );
 	int32_t GetUserCount() const;
-	std::vector< sptr_user > GetUserList();
 
 	void NotifyFriendsOnlineStatus( const sptr_user &user, bool onlineStatus );
 
 private:
+	// Where a user lives in m_users, and the keys it is currently indexed
+	// under so they can be dropped again without a scan.
+	struct IndexEntry {
+		size_t slot;
+		uint32_t usernameId;
+		uint32_t chatHandleId;
+		int64_t accountId;
+		std::vector< uint32_t > watching;
+	};
+
+	void UnbindKeys( const sptr_user &user, IndexEntry &entry );
+
 	std::mutex m_mutex;
 	std::vector< sptr_user > m_users;
-	std::mt19937 rng;
+	std::unordered_map< const RealmUser *, IndexEntry > m_entries;
+	std::unordered_map< uint32_t, sptr_user > m_byUsername;
+	std::unordered_map< uint32_t, sptr_user > m_byChatHandle;
+	std::unordered_map< int64_t, sptr_user > m_byAccountId;
+
+	// Reverse friend index: chat handle -> online users that list it.
+	std::unordered_map< uint32_t, std::unordered_set< sptr_user > > m_watchers;
 };
\ No newline at end of file
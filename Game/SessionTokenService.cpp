@@ -0,0 +1,116 @@
+#include "SessionTokenService.h"
+
+#include "../Common/Utility.h"
+#include "../Crypto/SecureRandom.h"
+#include "../logging.h"
+
+SessionTokenService::SessionTokenService() : m_slots( std::make_unique< Slot[] >( MAX_SLOTS ) )
+{
+}
+
+std::wstring SessionTokenService::Issue( const sptr_user &user )
+{
+	static const wchar_t charset[] = L"0123456789ABCDEF";
+
+	uint64_t token;
+	{
+		std::lock_guard< std::mutex > lock( m_writeMutex );
+
+		RevokeLocked( user->m_sessionKey );
+
+		uint32_t slot;
+		if( !m_freeSlots.empty() )
+		{
+			slot = m_freeSlots.back();
+			m_freeSlots.pop_back();
+		}
+		else if( m_slotCount < MAX_SLOTS )
+		{
+			slot = m_slotCount++;
+		}
+		else
+		{
+			Log::Error( "SessionTokenService::Issue() - No free session slots" );
+			return L"";
+		}
+
+		auto &entry = m_slots[ slot ];
+
+		// A zero token is reserved for "no session".
+		do
+		{
+			const uint64_t random = SecureRandom::NextU64() & 0xFFFFFFFFFFull;
+			token = ( uint64_t( slot ) << 48 ) | ( uint64_t( entry.generation ) << 40 ) | random;
+		} while( token == 0 );
+
+		// Publish the user before the token so a reader that matches the
+		// token also sees the user.
+		entry.user.store( user );
+		entry.token.store( token );
+	}
+
+	std::wstring sessionId( MAX_SESSION_ID_LENGTH, L'0' );
+	for( int i = MAX_SESSION_ID_LENGTH - 1; i >= 0; --i )
+	{
+		sessionId[ i ] = charset[ token & 0xF ];
+		token >>= 4;
+	}
+
+	return sessionId;
+}
+
+void SessionTokenService::Revoke( const sptr_user &user )
+{
+	std::lock_guard< std::mutex > lock( m_writeMutex );
+	RevokeLocked( user->m_sessionKey );
+}
+
+void SessionTokenService::RevokeLocked( uint64_t token )
+{
+	if( token == 0 )
+	{
+		return;
+	}
+
+	const auto slot = SlotOf( token );
+	if( slot >= m_slotCount || m_slots[ slot ].token.load() != token )
+	{
+		return;
+	}
+
+	auto &entry = m_slots[ slot ];
+	entry.token.store( 0 );
+	entry.user.store( wptr_user() );
+	entry.generation++;
+
+	m_freeSlots.push_back( slot );
+}
+
+sptr_user SessionTokenService::Resolve( const std::wstring &sessionId ) const
+{
+	return Resolve( Util::SessionKey( sessionId ) );
+}
+
+sptr_user SessionTokenService::Resolve( uint64_t sessionKey ) const
+{
+	if( sessionKey == 0 )
+	{
+		return nullptr;
+	}
+
+	const auto &entry = m_slots[ SlotOf( sessionKey ) ];
+	if( entry.token.load() != sessionKey )
+	{
+		return nullptr;
+	}
+
+	auto user = entry.user.load();
+
+	// The slot may have been revoked and reissued while the user was loaded.
+	if( entry.token.load() != sessionKey )
+	{
+		return nullptr;
+	}
+
+	return user.lock();
+}
\ No newline at end of file
@@ -0,0 +1,68 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "RealmUser.h"
+
+// Issues and resolves the 16 hex character session IDs handed to clients.
+//
+// A token is 64 bits: a 16-bit slot index, an 8-bit generation and 40
+// random bits from SecureRandom. Resolving a token is one array access
+// plus a compare against the token stored in the slot, so a stale token
+// (revoked, or from an earlier user of the same slot) never matches.
+// Revoking bumps the slot's generation before the slot is reused.
+//
+// Resolve is lock-free so the discovery thread never waits on the lobby.
+// The slot table is allocated up front and never moves. A slot's token is
+// checked before and after loading its user, so a slot revoked and reissued
+// in between is not mistaken for the original owner. Issue and Revoke only
+// lock the free list among themselves.
+class SessionTokenService
+{
+public:
+	static constexpr size_t MAX_SLOTS = 1 << 16;
+
+	static SessionTokenService &Get()
+	{
+		static SessionTokenService instance;
+		return instance;
+	}
+
+	SessionTokenService( const SessionTokenService & ) = delete;
+	SessionTokenService &operator=( const SessionTokenService & ) = delete;
+	SessionTokenService();
+
+	// Issues a new token for the user, revoking any token it already had.
+	// Returns an empty string if every slot is in use.
+	std::wstring Issue( const sptr_user &user );
+	void Revoke( const sptr_user &user );
+
+	sptr_user Resolve( const std::wstring &sessionId ) const;
+	sptr_user Resolve( uint64_t sessionKey ) const;
+
+private:
+	struct Slot {
+		std::atomic< uint64_t > token{ 0 };
+		std::atomic< wptr_user > user;
+		uint8_t generation = 0;	// Writers only.
+	};
+
+	static uint32_t SlotOf( uint64_t token )
+	{
+		return static_cast< uint32_t >( token >> 48 );
+	}
+
+	void RevokeLocked( uint64_t token );
+
+	std::unique_ptr< Slot[] > m_slots;
+
+	// Guards the free list and slot generations.
+	std::mutex m_writeMutex;
+	std::vector< uint32_t > m_freeSlots;
+	uint32_t m_slotCount = 0;
+};
\ No newline at end of file
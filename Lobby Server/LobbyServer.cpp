@@ -8,6 +8,8 @@
 #include "LobbyServer.h"
 
 #include "../Game/RealmUserManager.h"
+#include "../Crypto/CryptoWorkerPool.h"
+#include "LoginQueue.h"
 #include "../Network/Events.h"
 #include "../../configuration.h"
 #include "../../logging.h"
@@ -214,6 +216,11 @@ void LobbyServer::Run()
 				WriteSocket( client );
 			}
 		}
+
+		// Finish logins and account creations whose hashing is done, then
+		// admit more from the queue.
+		CryptoWorkerPool::Get().DrainCompletions();
+		LoginQueue::Get().Process();
 	}
 }
 
@@ -404,18 +411,16 @@ void LobbyServer::HandleRequest( sptr_socket socket, sptr_byte_stream stream )
 {
 	auto packetId = stream->read< uint16_t >();
 	stream->set_position( 0 );
+	stream->m_cipherCache = &socket->session_cipher;
 
-	auto it = REQUEST_EVENT.find( packetId );
-	if( it == REQUEST_EVENT.end() )
+	if( packetId > MAX_REQUEST_ID || REQUEST_EVENT[ packetId ] == nullptr )
 	{
 		Log::Error( "[LOBBY] Unknown packet id : {}", packetId );
 		Log::Packet( stream->m_buffer, stream->m_buffer.size(), false );
 		return;
 	}
 
-	auto request = it->second();
-
-	if( auto res = request->ProcessRequest( socket, stream ) )
+	if( auto res = REQUEST_EVENT[ packetId ]( socket, stream ) )
 	{
 		socket->send( res );
 	}
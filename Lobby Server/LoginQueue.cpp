@@ -0,0 +1,155 @@
+#include "LoginQueue.h"
+
+#include <algorithm>
+
+#include "../Crypto/CryptoWorkerPool.h"
+#include "../logging.h"
+
+void LoginQueue::Configure( size_t limit, size_t perAddressLimit, std::chrono::milliseconds maxWait, size_t admitDepth )
+{
+	m_limit = limit;
+	m_perAddressLimit = ( std::max )( perAddressLimit, size_t( 1 ) );
+	m_maxWait = maxWait;
+	m_admitDepth = ( std::max )( admitDepth, size_t( 1 ) );
+}
+
+bool LoginQueue::Push( const std::string &address, std::function< AdmitResult() > admit, std::function< void() > reject )
+{
+	if( m_length >= m_limit )
+	{
+		m_rejected++;
+		return false;
+	}
+
+	auto &pending = m_byAddress[ address ];
+	if( pending.size() >= m_perAddressLimit )
+	{
+		m_rejected++;
+		return false;
+	}
+
+	if( pending.empty() )
+	{
+		m_rotation.push_back( address );
+	}
+
+	pending.push_back( { std::move( admit ), std::move( reject ), std::chrono::steady_clock::now() } );
+	m_length++;
+
+	return true;
+}
+
+void LoginQueue::ExpireEntries( std::chrono::steady_clock::time_point now )
+{
+	// Each address queue is FIFO, so only the fronts need checking.
+	for( auto it = m_byAddress.begin(); it != m_byAddress.end(); )
+	{
+		auto &pending = it->second;
+
+		while( !pending.empty() && now - pending.front().queued > m_maxWait )
+		{
+			pending.front().reject();
+			pending.pop_front();
+			m_length--;
+			m_expired++;
+		}
+
+		if( pending.empty() )
+		{
+			std::erase( m_rotation, it->first );
+			it = m_byAddress.erase( it );
+		}
+		else
+		{
+			++it;
+		}
+	}
+}
+
+void LoginQueue::Process()
+{
+	const auto now = std::chrono::steady_clock::now();
+
+	if( m_length > 0 )
+	{
+		ExpireEntries( now );
+	}
+
+	auto &pool = CryptoWorkerPool::Get();
+
+	while( !m_rotation.empty() && pool.GetQueueDepth() < m_admitDepth )
+	{
+		auto address = std::move( m_rotation.front() );
+		m_rotation.pop_front();
+
+		auto it = m_byAddress.find( address );
+		if( it == m_byAddress.end() )
+		{
+			continue;
+		}
+
+		auto &pending = it->second;
+		auto entry = std::move( pending.front() );
+		pending.pop_front();
+		m_length--;
+
+		if( pending.empty() )
+		{
+			m_byAddress.erase( it );
+		}
+		else
+		{
+			m_rotation.push_back( std::move( address ) );
+		}
+
+		switch( entry.admit() )
+		{
+			case AdmitResult::Submitted:
+				m_admitted++;
+				break;
+
+			case AdmitResult::Failed:
+				entry.reject();
+				m_rejected++;
+				break;
+
+			case AdmitResult::Abandoned:
+				m_abandoned++;
+				break;
+		}
+	}
+
+	if( now - m_lastReport < std::chrono::minutes( 1 ) )
+		return;
+
+	m_lastReport = now;
+
+	auto stats = TakeStats();
+	if( stats.admitted == 0 && stats.rejected == 0 && stats.expired == 0 && stats.abandoned == 0 )
+		return;
+
+	Log::Info( "[LOGIN] queue {} admitted {} ({:.1f}/s) rejected {} expired {} abandoned {}",
+			   stats.length, stats.admitted, stats.admitRate, stats.rejected, stats.expired, stats.abandoned );
+}
+
+LoginQueue::Stats LoginQueue::TakeStats()
+{
+	const auto now = std::chrono::steady_clock::now();
+	const std::chrono::duration< double > elapsed = now - m_lastStats;
+	m_lastStats = now;
+
+	Stats stats{};
+	stats.length = m_length;
+	stats.admitted = m_admitted;
+	stats.rejected = m_rejected;
+	stats.expired = m_expired;
+	stats.abandoned = m_abandoned;
+	stats.admitRate = elapsed.count() > 0.0 ? m_admitted / elapsed.count() : 0.0;
+
+	m_admitted = 0;
+	m_rejected = 0;
+	m_expired = 0;
+	m_abandoned = 0;
+
+	return stats;
+}
\ No newline at end of file
@@ -0,0 +1,90 @@
+#pragma once
+
+#include <chrono>
+#include <deque>
+#include <functional>
+#include <string>
+#include <unordered_map>
+
+// Admission control for password checks (logins and account creation).
+//
+// Requests are queued per remote address and admitted round-robin across
+// addresses, so one host reconnecting many clients cannot starve the
+// rest. Entries are only handed to the crypto workers while the worker
+// queue is short; everything else waits here, and is rejected once it has
+// waited longer than the configured maximum or the queue is full. A
+// rejected client gets an immediate error reply instead of a slow one.
+//
+// Lobby thread only.
+class LoginQueue
+{
+public:
+	static LoginQueue &Get()
+	{
+		static LoginQueue instance;
+		return instance;
+	}
+
+	LoginQueue( const LoginQueue & ) = delete;
+	LoginQueue &operator=( const LoginQueue & ) = delete;
+	LoginQueue() = default;
+
+	enum class AdmitResult {
+		Submitted,	// Work was handed to the crypto workers.
+		Failed,		// Submitting failed; the entry is rejected.
+		Abandoned	// The client left while queued; nothing to do.
+	};
+
+	void Configure( size_t limit, size_t perAddressLimit, std::chrono::milliseconds maxWait, size_t admitDepth );
+
+	// admit submits the work and reports what happened; reject sends the
+	// error reply. Returns false, without calling either, if the entry
+	// cannot be queued.
+	bool Push( const std::string &address, std::function< AdmitResult() > admit, std::function< void() > reject );
+
+	// Expire old entries and admit as many as the workers can take.
+	void Process();
+
+	size_t GetLength() const
+	{
+		return m_length;
+	}
+
+	struct Stats {
+		size_t length;
+		uint64_t admitted;
+		uint64_t rejected;
+		uint64_t expired;
+		uint64_t abandoned;
+		double admitRate;
+	};
+
+	// Counters since the last call; length is the current value.
+	Stats TakeStats();
+
+private:
+	struct Entry {
+		std::function< AdmitResult() > admit;
+		std::function< void() > reject;
+		std::chrono::steady_clock::time_point queued;
+	};
+
+	size_t m_limit = 512;
+	size_t m_perAddressLimit = 4;
+	std::chrono::milliseconds m_maxWait = std::chrono::milliseconds( 5000 );
+	size_t m_admitDepth = 16;
+
+	std::unordered_map< std::string, std::deque< Entry > > m_byAddress;
+	std::deque< std::string > m_rotation;
+	size_t m_length = 0;
+
+	uint64_t m_admitted = 0;
+	uint64_t m_rejected = 0;
+	uint64_t m_expired = 0;
+	uint64_t m_abandoned = 0;
+
+	std::chrono::steady_clock::time_point m_lastStats = std::chrono::steady_clock::now();
+	std::chrono::steady_clock::time_point m_lastReport = std::chrono::steady_clock::now();
+
+	void ExpireEntries( std::chrono::steady_clock::time_point now );
+};
\ No newline at end of file
@@ -0,0 +1,132 @@
+#include "BrowseFrameCache.h"
+
+#include <format>
+
+#include "../Common/ByteStream.h"
+#include "../Common/Utility.h"
+#include "../Game/GameSessionManager.h"
+
+static StaticFrame EncodeAddress( const std::string &addr, int32_t port )
+{
+	ByteBuffer stream;
+	stream.write_utf16( std::format( L"{}:{}", Util::UTF8ToWide( addr ), port ) );
+
+	return std::move( stream.m_buffer );
+}
+
+static void BuildNorrath( BrowseFrame &frame, const std::vector< sptr_game_session > &games )
+{
+	const auto count = frame.count;
+
+	frame.hosts.reserve( games.size() );
+	for( const auto &game : games )
+	{
+		frame.hosts.push_back( {
+			game->m_hostExternalAddr,
+			EncodeAddress( game->m_hostLocalAddr, game->m_hostNatPort ),
+			EncodeAddress( game->m_hostExternalAddr, game->m_hostNatPort )
+		} );
+	}
+
+	ByteBuffer stream;
+
+	stream.write_u32( count );
+	for( const auto &game : games )
+		stream.write_utf16( game->m_gameName );
+
+	stream.write_u32( count );
+	for( const auto &game : games )
+		stream.write_utf16( game->m_ownerName );
+
+	stream.write_u32( count );
+	for( const auto &game : games )
+		stream.write_u32( game->m_gameId );
+
+	stream.write_u32( count );
+	for( const auto &game : games )
+		stream.write_utf8( game->m_gameData );
+
+	frame.tail = std::move( stream.m_buffer );
+}
+
+static void BuildArms( BrowseFrame &frame, const std::vector< sptr_game_session > &games )
+{
+	const auto count = frame.count;
+
+	ByteBuffer stream;
+
+	stream.write_u32( count );
+	for( const auto &game : games )
+		stream.write_utf16( Util::UTF8ToWide( game->m_gameData ) );
+
+	stream.write_u32( count );
+	for( const auto &game : games )
+		stream.write_utf16( game->m_playerCount );
+
+	stream.write_u32( count );
+	for( const auto &game : games )
+		stream.write_u32( game->m_gameId );
+
+	// Something about filtering.
+	stream.write_u32( count );
+	stream.write_u32( 0 );	// Size
+
+	stream.write_u32( count );
+	for( const auto &game : games )
+		stream.write_utf16( Util::UTF8ToWide( game->m_hostLocalAddr ) );
+
+	stream.write_u32( count );
+	for( const auto &game : games )
+		stream.write_u32( game->m_hostLocalPort );
+
+	stream.write_u32( count );
+	for( const auto &game : games )
+		stream.write_utf16( Util::UTF8ToWide( game->m_hostExternalAddr ) );
+
+	stream.write_u32( count );
+	for( const auto &game : games )
+		stream.write_u32( game->m_hostNatPort );
+
+	frame.tail = std::move( stream.m_buffer );
+}
+
+sptr_browse_frame BrowseFrameCache::GetFrame( RealmGameType gameType )
+{
+	std::lock_guard< std::mutex > lock( m_mutex );
+
+	auto &cached = m_frames[ gameType ];
+
+	const auto version = GameSessionManager::Get().GetBrowseVersion( gameType );
+	if( cached && cached->version == version )
+	{
+		return cached;
+	}
+
+	// The list and its version are read together, so a change that lands
+	// after this point only makes the next refresh rebuild again.
+	auto frame = std::make_shared< BrowseFrame >();
+
+	if( gameType == RealmGameType::RETURN_TO_ARMS )
+	{
+		// The match request carries no filter we can decode yet, so list
+		// every joinable game, fullest first so players fill open games.
+		MatchmakingIndex::Query query;
+		query.openSlotsOnly = true;
+		query.order = MatchmakingIndex::Order::Fill;
+
+		const auto games = GameSessionManager::Get().FindMatchingGames( query, frame->version );
+		frame->count = static_cast< uint32_t >( games.size() );
+
+		BuildArms( *frame, games );
+	}
+	else
+	{
+		const auto games = GameSessionManager::Get().GetAvailableGameSessionList( gameType, frame->version );
+		frame->count = static_cast< uint32_t >( games.size() );
+
+		BuildNorrath( *frame, games );
+	}
+
+	cached = std::move( frame );
+	return cached;
+}
\ No newline at end of file
@@ -0,0 +1,50 @@
+#pragma once
+
+#include <array>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "StaticFrameCache.h"
+
+// Encoded game browser list for one game type. Everything except the host
+// address array is the same for every client, so the address is kept in
+// both its LAN and WAN form and picked per requester; the remaining arrays
+// are stored as one pre-encoded tail.
+struct BrowseFrame {
+	struct HostAddress {
+		std::string externalAddr;
+		StaticFrame lan;
+		StaticFrame wan;
+	};
+
+	uint64_t version = ~0ull;
+	uint32_t count = 0;
+	std::vector< HostAddress > hosts;
+	StaticFrame tail;
+};
+
+using sptr_browse_frame = std::shared_ptr< const BrowseFrame >;
+
+// Caches the browse list encoding per game type and rebuilds it only when
+// the game session manager reports a newer browse version.
+class BrowseFrameCache
+{
+public:
+	static BrowseFrameCache &Get()
+	{
+		static BrowseFrameCache instance;
+		return instance;
+	}
+
+	BrowseFrameCache( const BrowseFrameCache & ) = delete;
+	BrowseFrameCache &operator=( const BrowseFrameCache & ) = delete;
+	BrowseFrameCache() = default;
+
+	sptr_browse_frame GetFrame( RealmGameType gameType );
+
+private:
+	std::mutex m_mutex;
+	std::array< sptr_browse_frame, 2 > m_frames;
+};
\ No newline at end of file
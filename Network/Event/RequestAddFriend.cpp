@@ -14,9 +14,7 @@ void RequestAddFriend::Deserialize( sptr_byte_stream stream )
 
 sptr_generic_response RequestAddFriend::ProcessRequest( sptr_socket socket, sptr_byte_stream stream )
 {
-	Deserialize( stream );
-
-	auto user = UserManager::Get().FindUserBySocket( socket );
+	auto user = socket->user.lock();
 	if( user == nullptr )
 	{
 		return std::make_shared< ResultAddFriend >( this, FATAL_ERROR );
@@ -33,7 +31,7 @@ sptr_generic_response RequestAddFriend::ProcessRequest( sptr_socket socket, sptr
 		return std::make_shared< ResultAddFriend >( this, FRIEND_INVALID );
 	}
 
-	if( targetUser->IsIgnored( user->m_chatHandle ) )
+	if( targetUser->IsIgnored( user->m_chatHandleId ) )
 	{
 		return std::make_shared< ResultAddFriend >( this, FRIEND_IGNORING );
 	}
@@ -43,7 +41,8 @@ sptr_generic_response RequestAddFriend::ProcessRequest( sptr_socket socket, sptr
 		return std::make_shared< ResultAddFriend >( this, DATABASE_ERROR );
 	}
 
-	user->m_friendList.push_back( targetUser->m_chatHandle );
+	user->AddFriend( targetUser->m_chatHandle );
+	UserManager::Get().WatchFriend( user, targetUser->m_chatHandle );
 
 	return std::make_shared< ResultAddFriend >( this, SUCCESS );
 }
@@ -14,9 +14,7 @@ void RequestAddIgnore::Deserialize( sptr_byte_stream stream )
 
 sptr_generic_response RequestAddIgnore::ProcessRequest( sptr_socket socket, sptr_byte_stream stream )
 {
-	Deserialize( stream );
-
-	auto user = UserManager::Get().FindUserBySocket( socket );
+	auto user = socket->user.lock();
 	if( user == nullptr )
 	{
 		return std::make_shared< ResultAddIgnore >( this, FATAL_ERROR );
@@ -43,7 +41,7 @@ sptr_generic_response RequestAddIgnore::ProcessRequest( sptr_socket socket, sptr
 		return std::make_shared< ResultAddIgnore >( this, DATABASE_ERROR );
 	}
 
-	user->m_ignoreList.push_back( targetUser->m_chatHandle );
+	user->AddIgnore( targetUser->m_chatHandle );
 
 	return std::make_shared< ResultAddIgnore >( this, SUCCESS );
 }
@@ -1,7 +1,6 @@
 #include "RequestAppendCharacterData.h"
 
 #include "../../Game/CharacterSaveManager.h"
-#include "../../Game/RealmUserManager.h"
 #include "../../Game/RealmUser.h"
 #include "../../Database/Database.h"
 #include "../../logging.h"
@@ -19,9 +18,7 @@ void RequestAppendCharacterData::Deserialize( sptr_byte_stream stream )
 
 sptr_generic_response RequestAppendCharacterData::ProcessRequest( sptr_socket socket, sptr_byte_stream stream )
 {
-	Deserialize( stream );
-
-	auto user = UserManager::Get().FindUserBySocket( socket );
+	auto user = socket->user.lock();
 	if( user == nullptr )
 	{
 		return std::make_shared< ResultAppendCharacterData >( this, FATAL_ERROR );
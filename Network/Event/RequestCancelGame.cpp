@@ -1,6 +1,5 @@
 #include "RequestCancelGame.h"
 
-#include "../../Game/RealmUserManager.h"
 #include "../../Game/GameSessionManager.h"
 #include "../../logging.h"
 
@@ -13,9 +12,7 @@ void RequestCancelGame::Deserialize( sptr_byte_stream stream )
 
 sptr_generic_response RequestCancelGame::ProcessRequest( sptr_socket socket, sptr_byte_stream stream )
 {
-	Deserialize( stream );
-
-	auto user = UserManager::Get().FindUserBySocket( socket );
+	auto user = socket->user.lock();
 	if( user == nullptr )
 	{
 		Log::Error( "User not found! [{}]", m_sessionId );
@@ -1,6 +1,5 @@
 #include "RequestCancelGame_RTA.h"
 
-#include "../../Game/RealmUserManager.h"
 #include "../../Game/GameSessionManager.h"
 #include "../../Game/ChatRoomManager.h"
 #include "../../logging.h"
@@ -14,9 +13,7 @@ void RequestCancelGame_RTA::Deserialize( sptr_byte_stream stream )
 
 sptr_generic_response RequestCancelGame_RTA::ProcessRequest( sptr_socket socket, sptr_byte_stream stream )
 {
-	Deserialize( stream );
-
-	auto user = UserManager::Get().FindUserBySocket( socket );
+	auto user = socket->user.lock();
 	if( user == nullptr )
 	{
 		Log::Error( "User not found! [{}]", m_sessionId );
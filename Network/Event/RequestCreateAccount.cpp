@@ -1,10 +1,12 @@
 #include "RequestCreateAccount.h"
 
 #include "../../Game/RealmUserManager.h"
+#include "../../Crypto/CryptoWorkerPool.h"
 #include "../../Crypto/PasswordHash.h"
 #include "../../Common/Constant.h"
 #include "../../Game/RealmUser.h"
 #include "../../Database/Database.h"
+#include "../../Lobby Server/LoginQueue.h"
 #include "../../logging.h"
 
 void RequestCreateAccount::Deserialize( sptr_byte_stream stream )
@@ -43,24 +45,70 @@ bool RequestCreateAccount::VerifyUserData()
 
 sptr_generic_response RequestCreateAccount::ProcessRequest( sptr_socket socket, sptr_byte_stream stream )
 {
-	Deserialize( stream );
-
-	auto user = UserManager::Get().FindUserBySocket( socket );
+	auto user = socket->user.lock();
 	if( nullptr == user || user->m_gameType != RealmGameType::RETURN_TO_ARMS )
 	{
-		return std::make_shared< ResultCreateAccount >( this, ERROR_FATAL, L"" );
+		return std::make_shared< ResultCreateAccount >( this, ERROR_FATAL );
 	}
 
 	if( m_username.empty() || m_password.empty() || m_emailAddress.empty() || m_dateOfBirth.empty() || m_chatHandle.empty() )
 	{
 		Log::Error( "RequestCreateAccount::ProcessRequest() - Missing required fields for account creation." );
-		return std::make_shared< ResultCreateAccount >( this, ERROR_FATAL, L"" );
+		return std::make_shared< ResultCreateAccount >( this, ERROR_FATAL );
+	}
+
+	auto queued = LoginQueue::Get().Push( socket->remote_ip,
+		[ request = *this, socket ]() mutable
+		{
+			return request.SubmitCreateAccount( socket );
+		},
+		[ request = *this, socket ]() mutable
+		{
+			socket->send( std::make_shared< ResultCreateAccount >( &request, ERROR_FATAL ) );
+		} );
+
+	if( !queued )
+	{
+		Log::Error( "RequestCreateAccount::ProcessRequest() - Login queue is full" );
+		return std::make_shared< ResultCreateAccount >( this, ERROR_FATAL );
+	}
+
+	return nullptr;
+}
+
+LoginQueue::AdmitResult RequestCreateAccount::SubmitCreateAccount( sptr_socket socket )
+{
+	if( socket->user.lock() == nullptr )
+	{
+		return LoginQueue::AdmitResult::Abandoned;
+	}
+
+	// Hash on a crypto worker; the insert happens back on the lobby thread.
+	auto salt = GeneratePasswordSalt( 32 );
+	auto iterations = GetPasswordIterations();
+
+	const bool submitted = CryptoWorkerPool::Get().SubmitDerive(
+		{ Util::WideToUTF8( m_password ), salt, iterations, 32 },
+		[ request = *this, socket, salt, iterations ]( std::vector< uint8_t > derived ) mutable
+		{
+			request.CompleteCreateAccount( socket, FormatPasswordHash( iterations, salt, derived ) );
+		} );
+
+	return submitted ? LoginQueue::AdmitResult::Submitted : LoginQueue::AdmitResult::Failed;
+}
+
+void RequestCreateAccount::CompleteCreateAccount( sptr_socket socket, const std::string &passwordHash )
+{
+	auto user = socket->user.lock();
+	if( nullptr == user )
+	{
+		return;
 	}
 
 	auto result = Database::Get().CreateNewAccount
 	(
 		Util::WideToUTF8( m_username ),
-		Util::WideToUTF8( m_password ),
+		passwordHash,
 		Util::WideToUTF8( m_emailAddress ),
 		Util::WideToUTF8( m_dateOfBirth ),
 		Util::WideToUTF8( m_chatHandle )
@@ -69,19 +117,26 @@ sptr_generic_response RequestCreateAccount::ProcessRequest( sptr_socket socket,
 	if( !result )
 	{
 		Log::Error( "RequestCreateAccount::ProcessRequest() - Failed to create account for user: {}", m_username );
-		return std::make_shared< ResultCreateAccount >( this, ERROR_FATAL, L"" );
+		socket->send( std::make_shared< ResultCreateAccount >( this, ERROR_FATAL ) );
+		return;
+	}
+
+	if( !user->SetSessionId( UserManager::Get().GenerateSessionId( user ) ) )
+	{
+		Log::Error( "RequestCreateAccount::ProcessRequest() - Failed to issue a session ID for user: {}", m_username );
+		socket->send( std::make_shared< ResultCreateAccount >( this, ERROR_FATAL ) );
+		return;
 	}
 
 	user->m_isLoggedIn = true;
-	user->m_sessionId = UserManager::Get().GenerateSessionId();
 	user->m_accountId = result;
-	user->m_username = m_username;
-	user->m_chatHandle = m_chatHandle;
+	user->SetIdentity( m_username, m_chatHandle );
+	UserManager::Get().BindUser( user );
 
-	return std::make_shared< ResultCreateAccount >( this, SUCCESS, user->m_sessionId );
+	socket->send( std::make_shared< ResultCreateAccount >( this, SUCCESS, user->m_sessionCipher ) );
 }
 
-ResultCreateAccount::ResultCreateAccount( GenericRequest *request, int32_t reply, std::wstring sessionId ) : GenericResponse( *request )
+ResultCreateAccount::ResultCreateAccount( GenericRequest *request, int32_t reply, const CachedCipherText &sessionId ) : GenericResponse( *request )
 {
 	m_reply = reply;
 	m_sessionId = sessionId;
@@ -5,6 +5,7 @@
 
 #include "../GenericNetRequest.h"
 #include "../GenericNetResponse.h"
+#include "../../Lobby Server/LoginQueue.h"
 
 class RequestCreateAccount : public GenericRequest
 {
@@ -22,6 +23,8 @@ private:
 	std::wstring m_chatHandle;
 
 	bool VerifyUserData();
+	LoginQueue::AdmitResult SubmitCreateAccount( sptr_socket socket );
+	void CompleteCreateAccount( sptr_socket socket, const std::string &passwordHash );
 
 public:
 	static std::unique_ptr< RequestCreateAccount > Create()
@@ -37,10 +40,10 @@ public:
 
 class ResultCreateAccount : public GenericResponse {
 private:
-	std::wstring m_sessionId;
+	CachedCipherText m_sessionId;
 	int32_t m_reply;
 
 public:
-	ResultCreateAccount( GenericRequest *request, int32_t reply, std::wstring sessionId );
+	ResultCreateAccount( GenericRequest *request, int32_t reply, const CachedCipherText &sessionId = {} );
 	void Serialize( ByteBuffer &out ) const;
 };
\ No newline at end of file
@@ -2,7 +2,6 @@
 
 #include "../../Database/Database.h"
 #include "../../Game/CharacterSaveManager.h"
-#include "../../Game/RealmUserManager.h"
 #include "../../Game/RealmUser.h"
 #include "../../Game/RealmCharacter.h"
 #include "../../logging.h"
@@ -24,9 +23,7 @@ void RequestCreateNewCharacter_RTA::Deserialize( sptr_byte_stream stream )
 
 sptr_generic_response RequestCreateNewCharacter_RTA::ProcessRequest( sptr_socket socket, sptr_byte_stream stream )
 {
-	Deserialize( stream );
-
-	auto user = UserManager::Get().FindUserBySocket( socket );
+	auto user = socket->user.lock();
 	if( user == nullptr )
 	{
 		Log::Error( "User not found! [{}]", m_sessionId );
@@ -1,6 +1,5 @@
 #include "RequestCreatePrivateGame_RTA.h"
 
-#include "../../Game/RealmUserManager.h"
 #include "../../Game/GameSessionManager.h"
 #include "../../configuration.h"
 #include "../../logging.h"
@@ -17,9 +16,7 @@ void RequestCreatePrivateGame_RTA::Deserialize( sptr_byte_stream stream )
 
 sptr_generic_response RequestCreatePrivateGame_RTA::ProcessRequest( sptr_socket socket, sptr_byte_stream stream )
 {
-	Deserialize( stream );
-
-	auto user = UserManager::Get().FindUserBySocket( socket );
+	auto user = socket->user.lock();
 	if( user == nullptr )
 	{
 		Log::Error( "User not found! [{}]", m_sessionId );
@@ -1,6 +1,5 @@
 #include "RequestCreatePrivateRoom.h"
 
-#include "../../Game/RealmUserManager.h"
 #include "../../Game/ChatRoomManager.h"
 #include "../../logging.h"
 
@@ -14,9 +13,7 @@ void RequestCreatePrivateRoom::Deserialize( sptr_byte_stream stream )
 
 sptr_generic_response RequestCreatePrivateRoom::ProcessRequest( sptr_socket socket, sptr_byte_stream stream )
 {
-	Deserialize( stream );
-
-	auto user = UserManager::Get().FindUserBySocket( socket );
+	auto user = socket->user.lock();
 	if( user == nullptr )
 	{
 		return std::make_shared< ResultCreatePrivateRoom >( this );
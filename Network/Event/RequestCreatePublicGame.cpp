@@ -1,6 +1,5 @@
 #include "RequestCreatePublicGame.h"
 
-#include "../../Game/RealmUserManager.h"
 #include "../../Game/GameSessionManager.h"
 #include "../../configuration.h"
 #include "../../logging.h"
@@ -45,9 +44,7 @@ std::tuple<std::wstring, std::wstring> RequestCreatePublicGame::ParseNameAndStag
 
 sptr_generic_response RequestCreatePublicGame::ProcessRequest( sptr_socket socket, sptr_byte_stream stream )
 {
-	Deserialize( stream );
-
-	auto user = UserManager::Get().FindUserBySocket( socket );
+	auto user = socket->user.lock();
 	if( user == nullptr )
 	{
 		Log::Error( "User not found! [{}]", m_sessionId );
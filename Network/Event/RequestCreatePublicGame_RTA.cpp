@@ -1,6 +1,5 @@
 #include "RequestCreatePublicGame_RTA.h"
 
-#include "../../Game/RealmUserManager.h"
 #include "../../Game/GameSessionManager.h"
 #include "../../Game/ChatRoomManager.h"
 #include "../../configuration.h"
@@ -66,14 +65,14 @@ bool RequestCreatePublicGame_RTA::ParseGameInfo()
 		}
 	}
 
+	m_attributes = fields;
+
 	return true;
 }
 
 sptr_generic_response RequestCreatePublicGame_RTA::ProcessRequest( sptr_socket socket, sptr_byte_stream stream )
 {
-	Deserialize( stream );
-
-	auto user = UserManager::Get().FindUserBySocket( socket );
+	auto user = socket->user.lock();
 	if( user == nullptr )
 	{
 		Log::Error( "User not found! [{}]", m_sessionId );
@@ -16,7 +16,7 @@ private:
 	std::string m_localAddr;
 	int32_t m_localPort;
 
-	std::array< int8_t, 5 > m_attributes;
+	std::array< int8_t, 5 > m_attributes = {};
 
 	enum ERROR_CODE {
 		SUCCESS = 0,
@@ -1,6 +1,5 @@
 #include "RequestEnterRoom.h"
 
-#include "../../Game/RealmUserManager.h"
 #include "../../Game/ChatRoomManager.h"
 #include "../../logging.h"
 
@@ -14,9 +13,7 @@ void RequestEnterRoom::Deserialize( sptr_byte_stream stream )
 
 sptr_generic_response RequestEnterRoom::ProcessRequest( sptr_socket socket, sptr_byte_stream stream )
 {
-	Deserialize( stream );
-
-	const auto user = UserManager::Get().FindUserBySocket( socket );
+	const auto user = socket->user.lock();
 	if( !user )
 	{
 		Log::Error( "User not found for socket!" );
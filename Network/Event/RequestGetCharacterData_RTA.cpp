@@ -1,6 +1,5 @@
 #include "RequestGetCharacterData_RTA.h"
 
-#include "../../Game/RealmUserManager.h"
 #include "../../Game/RealmUser.h"
 #include "../../Database/Database.h"
 #include "../../logging.h"
@@ -15,9 +14,7 @@ void RequestGetNetCharacterData_RTA::Deserialize( sptr_byte_stream stream )
 
 sptr_generic_response RequestGetNetCharacterData_RTA::ProcessRequest( sptr_socket socket, sptr_byte_stream stream )
 {
-	Deserialize( stream );
-
-	auto user = UserManager::Get().FindUserBySocket( socket );
+	auto user = socket->user.lock();
 	if( user == nullptr )
 	{
 		return std::make_shared< ResultGetNetCharacterData_RTA >( this, FATAL_ERROR );
@@ -5,6 +5,7 @@
 
 #include "../GenericNetRequest.h"
 #include "../GenericNetResponse.h"
+#include "../StaticFrameCache.h"
 
 class RequestGetEncryptionKey : public GenericRequest
 {
@@ -20,7 +21,7 @@ public:
 
 class ResultGetEncryptionKey : public GenericResponse {
 public:
-	std::vector< uint8_t > m_symKey;
+	sptr_static_frame m_frame;
 
 	ResultGetEncryptionKey( GenericRequest *request );
 	void Serialize( ByteBuffer &out ) const;
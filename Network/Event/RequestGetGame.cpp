@@ -1,6 +1,5 @@
 #include "RequestGetGame.h"
 
-#include "../../Game/RealmUserManager.h"
 #include "../../Game/GameSessionManager.h"
 #include "../../Game/RealmUser.h"
 #include "../../logging.h"
@@ -15,9 +14,7 @@ void RequestGetGame::Deserialize( sptr_byte_stream stream )
 
 sptr_generic_response RequestGetGame::ProcessRequest( sptr_socket socket, sptr_byte_stream stream )
 {
-	Deserialize( stream );
-
-	auto user = UserManager::Get().FindUserBySocket( socket );
+	auto user = socket->user.lock();
 	if( user == nullptr )
 	{
 		Log::Error( "User not found! [{}]", m_sessionId );
@@ -1,7 +1,6 @@
 #include "RequestGetNetCharacterList_RTA.h"
 
 #include "../../Game/RealmUser.h"
-#include "../../Game/RealmUserManager.h"
 #include "../../Game/RealmCharacterMetaKV.h"
 #include "../../Database/Database.h"
 #include "../../logging.h"
@@ -13,9 +12,7 @@ void RequestGetNetCharacterList_RTA::Deserialize( sptr_byte_stream stream )
 
 sptr_generic_response RequestGetNetCharacterList_RTA::ProcessRequest( sptr_socket socket, sptr_byte_stream stream )
 {
-	Deserialize( stream );
-
-	auto user = UserManager::Get().FindUserBySocket( socket );
+	auto user = socket->user.lock();
 	if( !user )
 	{
 		return std::make_shared< ResultGetNetCharacterList_RTA >( this, FATAL_ERROR, std::nullopt );
@@ -9,8 +9,6 @@ void RequestGetPublicRooms::Deserialize( sptr_byte_stream stream )
 
 sptr_generic_response RequestGetPublicRooms::ProcessRequest( sptr_socket socket, sptr_byte_stream stream )
 {
-	Deserialize( stream );
-
 	const auto publicRooms = ChatRoomManager::Get().GetPublicRoomList();
 
 	return std::make_shared< ResultGetPublicRooms >( this, publicRooms );
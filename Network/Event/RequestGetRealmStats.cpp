@@ -9,8 +9,6 @@ void RequestGetRealmStats::Deserialize( sptr_byte_stream stream )
 
 sptr_generic_response RequestGetRealmStats::ProcessRequest( sptr_socket socket, sptr_byte_stream stream )
 {
-	Deserialize( stream );
-
 	return std::make_shared< ResultGetRealmStats >( this );
 }
 
@@ -1,6 +1,5 @@
 #include "RequestGetRoom.h"
 
-#include "../../Game/RealmUserManager.h"
 #include "../../Game/ChatRoomManager.h"
 
 #include "../../logging.h"
@@ -15,9 +14,7 @@ void RequestGetRoom::Deserialize( sptr_byte_stream stream )
 
 sptr_generic_response RequestGetRoom::ProcessRequest( sptr_socket socket, sptr_byte_stream stream )
 {
-	Deserialize( stream );
-
-	const auto user = UserManager::Get().FindUserBySocket( socket );
+	const auto user = socket->user.lock();
 	if( !user )
 	{
 		return std::make_shared< ResultGetRoom >( this, GENERAL_ERROR );
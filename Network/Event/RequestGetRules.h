@@ -5,6 +5,7 @@
 
 #include "../GenericNetRequest.h"
 #include "../GenericNetResponse.h"
+#include "../StaticFrameCache.h"
 
 class RequestGetRules : public GenericRequest
 {
@@ -23,9 +24,9 @@ public:
 
 class ResultGetRules : public GenericResponse {
 private:
-	std::wstring m_rules;
+	sptr_static_frame m_frame;
 
 public:
-	ResultGetRules( GenericRequest *request, std::wstring rules );
+	ResultGetRules( GenericRequest *request, sptr_static_frame frame );
 	void Serialize( ByteBuffer &out ) const;
 };
\ No newline at end of file
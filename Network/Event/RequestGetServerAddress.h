@@ -5,6 +5,7 @@
 
 #include "../GenericNetRequest.h"
 #include "../GenericNetResponse.h"
+#include "../StaticFrameCache.h"
 #include "../../Common/Constant.h"
 
 class RequestGetServerAddress : public GenericRequest {
@@ -20,10 +21,8 @@ public:
 
 class ResultGetServerAddress : public GenericResponse {
 public:
-	std::string m_ip;
-	int32_t		m_port;
-	RealmGameType m_gameType;
+	sptr_static_frame m_frame;
 
-	ResultGetServerAddress( GenericRequest *request, std::string ip, int32_t port, RealmGameType clientType );
+	ResultGetServerAddress( GenericRequest *request, sptr_static_frame frame );
 	void Serialize( ByteBuffer &out ) const;
 };
\ No newline at end of file
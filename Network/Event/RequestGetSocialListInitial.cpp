@@ -1,6 +1,5 @@
 #include "RequestGetSocialListInitial.h"
 
-#include "../../Game/RealmUserManager.h"
 #include "../../Game/RealmUser.h"
 #include "../../logging.h"
 
@@ -11,9 +10,7 @@ void RequestGetSocialListInitial::Deserialize( sptr_byte_stream stream )
 
 sptr_generic_response RequestGetSocialListInitial::ProcessRequest( sptr_socket socket, sptr_byte_stream stream )
 {
-	Deserialize( stream );
-
-	auto user = UserManager::Get().FindUserBySocket( socket );
+	auto user = socket->user.lock();
 	if( user == nullptr )
 	{
 		Log::Error( "RequestGetFriendList::ProcessRequest() - User not found" );
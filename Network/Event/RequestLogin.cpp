@@ -1,6 +1,9 @@
 #include "RequestLogin.h"
 
+#include "../../Crypto/CryptoWorkerPool.h"
+#include "../../Crypto/PasswordHash.h"
 #include "../../Database/Database.h"
+#include "../../Lobby Server/LoginQueue.h"
 #include "../../Game/RealmUserManager.h"
 #include "../../Game/RealmUser.h"
 #include "../../Common/Constant.h"
@@ -23,76 +26,176 @@ sptr_generic_response RequestLogin::ProcessLoginCON( sptr_user user )
 		Log::Debug( "RequestLogin : Champions of Norrath v1.0" );
 
 		// TODO: Either block this, or add support for the network beta.
-		return std::make_shared< ResultLogin >( this, LOGIN_REPLY::ACCOUNT_INVALID, L"" );
+		return std::make_shared< ResultLogin >( this, LOGIN_REPLY::ACCOUNT_INVALID );
+	}
+
+	if( !user->SetSessionId( UserManager::Get().GenerateSessionId( user ) ) )
+	{
+		Log::Error( "RequestLogin::ProcessLoginCON() - Failed to issue a session ID" );
+		return std::make_shared< ResultLogin >( this, FATAL_ERROR );
 	}
 
 	user->m_isLoggedIn = true;
 	user->m_accountId = -1;
-	user->m_sessionId = UserManager::Get().GenerateSessionId();
+	UserManager::Get().BindUser( user );
 
-	return std::make_shared< ResultLogin >( this, SUCCESS, user->m_sessionId );
+	return std::make_shared< ResultLogin >( this, SUCCESS, user->m_sessionCipher );
 }
 
-sptr_generic_response RequestLogin::ProcessLoginRTA( sptr_user user )
+sptr_generic_response RequestLogin::ProcessLoginRTA( sptr_socket socket )
 {
 	// Return to Arms uses login information.
 	Log::Debug( "RequestLogin : Return to Arms" );
 
+	// Verify the account exists
+	auto [ found, accountId, passwordHash, chatHandle ] = Database::Get().LoadAccountCredentials( m_username );
+
+	if( !found || accountId < 0 )
+	{
+		Log::Error( "RequestLogin::ProcessRequest() - Invalid account ID: " + std::to_string( accountId ) );
+		return std::make_shared< ResultLogin >( this, ACCOUNT_INVALID );
+	}
+
+	uint32_t iterations;
+	std::vector< uint8_t > salt, expected;
+
+	if( !ParsePasswordHash( passwordHash, iterations, salt, expected ) )
+	{
+		Log::Error( "RequestLogin::ProcessRequest() - Invalid password hash for account ID: {}", accountId );
+		return std::make_shared< ResultLogin >( this, ACCOUNT_INVALID );
+	}
+
+	// The request object is recycled once we return, so the queued
+	// callbacks work from their own copy.
+	auto queued = LoginQueue::Get().Push( socket->remote_ip,
+		[ request = *this, socket, accountId, chatHandle, salt, expected, iterations ]() mutable
+		{
+			return request.SubmitLoginRTA( socket, accountId, chatHandle, salt, expected, iterations );
+		},
+		[ request = *this, socket ]() mutable
+		{
+			socket->send( std::make_shared< ResultLogin >( &request, FATAL_ERROR ) );
+		} );
+
+	if( !queued )
+	{
+		Log::Error( "RequestLogin::ProcessRequest() - Login queue is full" );
+		return std::make_shared< ResultLogin >( this, FATAL_ERROR );
+	}
+
+	return nullptr;
+}
+
+LoginQueue::AdmitResult RequestLogin::SubmitLoginRTA( sptr_socket socket, int64_t accountId, const std::wstring &chatHandle,
+													  const std::vector< uint8_t > &salt, const std::vector< uint8_t > &expected, uint32_t iterations )
+{
+	// Nothing to do if the client left while queued.
+	if( socket->user.lock() == nullptr )
+	{
+		return LoginQueue::AdmitResult::Abandoned;
+	}
+
+	const bool submitted = CryptoWorkerPool::Get().SubmitDerive(
+		{ Util::WideToUTF8( m_password ), salt, iterations, expected.size() },
+		[ request = *this, socket, accountId, chatHandle, expected, iterations ]( std::vector< uint8_t > derived ) mutable
+		{
+			const bool verified = derived == expected;
+			request.CompleteLoginRTA( socket, verified, accountId, chatHandle );
+
+			if( verified && PasswordNeedsRehash( iterations ) )
+			{
+				request.RehashPassword( accountId, iterations );
+			}
+		} );
+
+	return submitted ? LoginQueue::AdmitResult::Submitted : LoginQueue::AdmitResult::Failed;
+}
+
+void RequestLogin::CompleteLoginRTA( sptr_socket socket, bool verified, int64_t accountId, const std::wstring &chatHandle )
+{
 	auto &UserManager = UserManager::Get();
 	auto &Database = Database::Get();
 
-	// Verify the account exists
-	auto [ result, accountId, chatHandle ] = Database.VerifyAccount( m_username, m_password );
+	// The client may have gone away while the password was being checked.
+	auto user = socket->user.lock();
+	if( user == nullptr )
+	{
+		return;
+	}
 
-	if( accountId < 0 )
+	if( !verified )
 	{
-		Log::Error( "RequestLogin::ProcessRequest() - Invalid account ID: " + std::to_string( accountId ) );
-		return std::make_shared< ResultLogin >( this, ACCOUNT_INVALID, L"" );
+		Log::Error( "Invalid credentials for account ID: {}", accountId );
+		socket->send( std::make_shared< ResultLogin >( this, ACCOUNT_INVALID ) );
+		return;
 	}
 
 	// Check if the user is already logged in
-	for( const auto &existingUser : UserManager.GetUserList() )
+	if( UserManager.FindUserByAccountId( accountId ) || UserManager.FindUserByUsername( m_username ) )
 	{
-		if( existingUser->m_username == m_username || existingUser->m_accountId == accountId )
-		{
-			return std::make_shared< ResultLogin >( this, FATAL_ERROR, L"" );
-		}
+		socket->send( std::make_shared< ResultLogin >( this, FATAL_ERROR ) );
+		return;
+	}
+
+	Log::Debug( "Account verified: {} (ID: {})", m_username, accountId );
+
+	if( !user->SetSessionId( UserManager.GenerateSessionId( user ) ) )
+	{
+		Log::Error( "Failed to issue a session ID for account ID: {}", accountId );
+		socket->send( std::make_shared< ResultLogin >( this, FATAL_ERROR ) );
+		return;
 	}
 
 	// Login Success
 	user->m_isLoggedIn = true;
-	user->m_username = m_username;
 	user->m_accountId = accountId;
-	user->m_chatHandle = chatHandle;
-	user->m_sessionId = UserManager.GenerateSessionId();
+	user->SetIdentity( m_username, chatHandle );
 
 	// Load Friend List
-	user->m_friendList = Database.LoadFriends( accountId );
+	user->SetFriendList( Database.LoadFriends( accountId ) );
 
 	// Load Ignore List
-	user->m_ignoreList = Database.LoadIgnores( accountId );
+	user->SetIgnoreList( Database.LoadIgnores( accountId ) );
+
+	UserManager.BindUser( user );
 
 	// Notify friends about the user's online status
 	UserManager.NotifyFriendsOnlineStatus( user, true );
 
-	return std::make_shared< ResultLogin >( this, SUCCESS, user->m_sessionId );
+	socket->send( std::make_shared< ResultLogin >( this, SUCCESS, user->m_sessionCipher ) );
 }
 
-sptr_generic_response RequestLogin::ProcessRequest( sptr_socket socket, sptr_byte_stream stream )
+void RequestLogin::RehashPassword( int64_t accountId, uint32_t oldIterations )
 {
-	Deserialize( stream );
+	// Bring the stored cost in line with the calibrated target. This is
+	// best effort; if the queue is busy it will be retried next login.
+	auto salt = GeneratePasswordSalt( 32 );
+	auto iterations = GetPasswordIterations();
+
+	CryptoWorkerPool::Get().SubmitDerive(
+		{ Util::WideToUTF8( m_password ), salt, iterations, 32 },
+		[ accountId, salt, iterations, oldIterations ]( std::vector< uint8_t > derived )
+		{
+			if( Database::Get().UpdatePassword( accountId, FormatPasswordHash( iterations, salt, derived ) ) )
+			{
+				Log::Debug( "Rehashed password for account ID {} ({} -> {} iterations)", accountId, oldIterations, iterations );
+			}
+		} );
+}
 
-	auto user = UserManager::Get().FindUserBySocket( socket );
+sptr_generic_response RequestLogin::ProcessRequest( sptr_socket socket, sptr_byte_stream stream )
+{
+	auto user = socket->user.lock();
 	if( user == nullptr )
 	{
 		Log::Error( "RequestLogin::ProcessRequest() - User not found" );
-		return std::make_shared< ResultLogin >( this, ACCOUNT_INVALID, L"" );
+		return std::make_shared< ResultLogin >( this, ACCOUNT_INVALID );
 	}
 
 	if( m_username.empty() || m_password.empty() )
 	{
 		Log::Error( "RequestLogin::ProcessRequest() - Username or password is empty" );
-		return std::make_shared< ResultLogin >( this, ACCOUNT_INVALID, L"" );
+		return std::make_shared< ResultLogin >( this, ACCOUNT_INVALID );
 	}
 
 	if( user->m_gameType == RealmGameType::CHAMPIONS_OF_NORRATH )
@@ -101,14 +204,15 @@ sptr_generic_response RequestLogin::ProcessRequest( sptr_socket socket, sptr_byt
 	}
 	else
 	{
-		return ProcessLoginRTA( user );
+		return ProcessLoginRTA( socket );
 	}
 }
 
-ResultLogin::ResultLogin( GenericRequest *request, int32_t reply, std::wstring sessionId ) : GenericResponse( *request )
+ResultLogin::ResultLogin( GenericRequest *request, int32_t reply, const CachedCipherText &sessionId ) : GenericResponse( *request )
 {
 	m_reply = reply;
 	m_sessionId = sessionId;
+	m_trailer = StaticFrameCache::Get().GetLoginTrailer();
 }
 
 void ResultLogin::Serialize( ByteBuffer &out ) const
@@ -118,5 +222,5 @@ void ResultLogin::Serialize( ByteBuffer &out ) const
 	out.write_u32( m_reply );
 
 	out.write_encrypted_utf16( m_sessionId );
-	out.write_encrypted_utf16( L"UNKNOWN DUMMY STRING" );
+	out.write_bytes( *m_trailer );
 }
@@ -5,6 +5,8 @@
 
 #include "../GenericNetRequest.h"
 #include "../GenericNetResponse.h"
+#include "../StaticFrameCache.h"
+#include "../../Lobby Server/LoginQueue.h"
 
 class RequestLogin : public GenericRequest
 {
@@ -29,15 +31,20 @@ public:
 	void Deserialize( sptr_byte_stream stream ) override;
 
 	sptr_generic_response ProcessLoginCON( sptr_user user );
-	sptr_generic_response ProcessLoginRTA( sptr_user user );
+	sptr_generic_response ProcessLoginRTA( sptr_socket socket );
+	LoginQueue::AdmitResult SubmitLoginRTA( sptr_socket socket, int64_t accountId, const std::wstring &chatHandle,
+											const std::vector< uint8_t > &salt, const std::vector< uint8_t > &expected, uint32_t iterations );
+	void CompleteLoginRTA( sptr_socket socket, bool verified, int64_t accountId, const std::wstring &chatHandle );
+	void RehashPassword( int64_t accountId, uint32_t oldIterations );
 };
 
 class ResultLogin : public GenericResponse {
 private:
-	std::wstring m_sessionId;
+	CachedCipherText m_sessionId;
 	int32_t m_reply;
+	sptr_static_frame m_trailer;
 
 public:
-	ResultLogin( GenericRequest *request, int32_t reply, std::wstring sessionId );
+	ResultLogin( GenericRequest *request, int32_t reply, const CachedCipherText &sessionId = {} );
 	void Serialize( ByteBuffer &out ) const;
 };
\ No newline at end of file
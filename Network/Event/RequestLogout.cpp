@@ -11,8 +11,6 @@ void RequestLogout::Deserialize( sptr_byte_stream stream )
 
 sptr_generic_response RequestLogout::ProcessRequest( sptr_socket socket, sptr_byte_stream stream )
 {
-	Deserialize( stream );
-
 	UserManager::Get().RemoveUser( socket );
 
 	Log::Debug( "[{}] Logout", m_sessionId );
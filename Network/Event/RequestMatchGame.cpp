@@ -1,11 +1,10 @@
 #include "RequestMatchGame.h"
 
-#include <format>
-
 #include "../../Common/Constant.h"
 #include "../../Game/RealmUserManager.h"
 #include "../../Game/GameSessionManager.h"
 #include "../../Game/RealmUser.h"
+#include "../BrowseFrameCache.h"
 
 void RequestMatchGame::Deserialize( sptr_byte_stream stream )
 {
@@ -20,6 +19,13 @@ void RequestMatchGame::Deserialize( sptr_byte_stream stream )
 
 	auto unknown_e = stream->read_u32();
 
+	// Every node is at least 24 bytes, reject counts the packet can't hold
+	// before looping over them.
+	if( !stream->require( static_cast< size_t >( unknown_e ) * 24 ) )
+	{
+		return;
+	}
+
 	// Match Game Node Count
 	for( uint32_t i = 0; i < unknown_e; i++ )
 	{
@@ -41,8 +47,6 @@ void RequestMatchGame::Deserialize( sptr_byte_stream stream )
 
 sptr_generic_response RequestMatchGame::ProcessRequest( sptr_socket socket, sptr_byte_stream stream )
 {
-	Deserialize( stream );
-
 	return std::make_shared< ResultMatchGame >( this, socket->remote_ip );
 }
 
@@ -57,41 +61,14 @@ void ResultMatchGame::Serialize( ByteBuffer &out ) const
 	out.write_u32( m_trackId );
 	out.write_u32( 0 );
 
-	const auto publicGameList = GameSessionManager::Get().GetAvailableGameSessionList( RealmGameType::CHAMPIONS_OF_NORRATH );
-	const auto publicGameCount = static_cast< uint32_t >( publicGameList.size() );
-
-	out.write_u32( publicGameCount );
-	{
-		for( const auto &game : publicGameList )
-		{
-			if( m_userIp == game->m_hostExternalAddr )
-				out.write_utf16( std::format( L"{}:{}", Util::UTF8ToWide( game->m_hostLocalAddr ), game->m_hostNatPort ) );
-			else
-				out.write_utf16( std::format( L"{}:{}", Util::UTF8ToWide( game->m_hostExternalAddr ), game->m_hostNatPort ) );
-		}
-	}
-
-	out.write_u32( publicGameCount );
-	{
-		for( const auto &game : publicGameList )
-			out.write_utf16( game->m_gameName );
-	}
-
-	out.write_u32( publicGameCount );
-	{
-		for( const auto &game : publicGameList )
-			out.write_utf16( game->m_ownerName );
-	}
+	const auto frame = BrowseFrameCache::Get().GetFrame( RealmGameType::CHAMPIONS_OF_NORRATH );
 
-	out.write_u32( publicGameCount );
+	// Hosts behind the same NAT as the requester are given their LAN address.
+	out.write_u32( frame->count );
+	for( const auto &host : frame->hosts )
 	{
-		for( const auto &game : publicGameList )
-			out.write_u32( game->m_gameId );
+		out.write_bytes( m_userIp == host.externalAddr ? host.lan : host.wan );
 	}
 
-	out.write_u32( publicGameCount );
-	{
-		for( const auto &game : publicGameList )
-			out.write_utf8( game->m_gameData );
-	}
+	out.write_bytes( frame->tail );
 }
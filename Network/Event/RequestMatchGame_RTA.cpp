@@ -3,6 +3,7 @@
 #include "../../Game/RealmUserManager.h"
 #include "../../Game/GameSessionManager.h"
 #include "../../logging.h"
+#include "../BrowseFrameCache.h"
 
 void RequestMatchGame_RTA::Deserialize( sptr_byte_stream stream )
 {
@@ -11,9 +12,7 @@ void RequestMatchGame_RTA::Deserialize( sptr_byte_stream stream )
 
 sptr_generic_response RequestMatchGame_RTA::ProcessRequest( sptr_socket socket, sptr_byte_stream stream )
 {
-	Deserialize( stream );
-
-	auto user = UserManager::Get().FindUserBySocket( socket );
+	auto user = socket->user.lock();
 	if( user == nullptr )
 	{
 		UserManager::Get().Disconnect( socket, "User not found!" );
@@ -40,54 +39,6 @@ void ResultMatchGame_RTA::Serialize( ByteBuffer &out ) const
 	out.write_u32( m_trackId );
 	out.write_u32( 0 );
 
-	const auto publicGameList = GameSessionManager::Get().GetAvailableGameSessionList( RealmGameType::RETURN_TO_ARMS );
-	const auto publicGameCount = static_cast< uint32_t >( publicGameList.size() );
-
-	out.write_u32( publicGameCount );
-	{
-		for( const auto &game : publicGameList )
-			out.write_utf16( Util::UTF8ToWide( game->m_gameData ) );
-	}
-
-	out.write_u32( publicGameCount );
-	{
-		for( const auto &game : publicGameList )
-			out.write_utf16( game->m_playerCount );
-	}
-
-	out.write_u32( publicGameCount );
-	{
-		for( const auto &game : publicGameList )
-			out.write_u32( game->m_gameId );
-	}
-
-	// Something about filtering.
-	out.write_u32( publicGameCount );
-	{
-		out.write_u32( 0 );	// Size
-	}
-
-	out.write_u32( publicGameCount );
-	{
-		for( const auto &game : publicGameList )
-			out.write_utf16( Util::UTF8ToWide( game->m_hostLocalAddr ) );
-	}
-
-	out.write_u32( publicGameCount );
-	{
-		for( const auto &game : publicGameList )
-			out.write_u32( game->m_hostLocalPort );
-	}
-
-	out.write_u32( publicGameCount );
-	{
-		for( const auto &game : publicGameList )
-			out.write_utf16( Util::UTF8ToWide( game->m_hostExternalAddr ) );
-	}
-
-	out.write_u32( publicGameCount );
-	{
-		for( const auto &game : publicGameList )
-			out.write_u32( game->m_hostNatPort );
-	}
+	const auto frame = BrowseFrameCache::Get().GetFrame( RealmGameType::RETURN_TO_ARMS );
+	out.write_bytes( frame->tail );
 }
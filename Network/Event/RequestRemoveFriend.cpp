@@ -14,9 +14,7 @@ void RequestRemoveFriend::Deserialize( sptr_byte_stream stream )
 
 sptr_generic_response RequestRemoveFriend::ProcessRequest( sptr_socket socket, sptr_byte_stream stream )
 {
-	Deserialize( stream );
-
-	auto user = UserManager::Get().FindUserBySocket( socket );
+	auto user = socket->user.lock();
 	if( user == nullptr )
 	{
 		return std::make_shared< ResultRemoveFriend >( this, FATAL_ERROR );
@@ -32,13 +30,12 @@ sptr_generic_response RequestRemoveFriend::ProcessRequest( sptr_socket socket, s
 		return std::make_shared< ResultRemoveFriend >( this, DATABASE_ERROR );
 	}
 
-	const auto iter = std::find( user->m_friendList.begin(), user->m_friendList.end(), m_chatHandle );
-	if( iter == user->m_friendList.end() )
+	if( !user->RemoveFriend( m_chatHandle ) )
 	{
 		return std::make_shared< ResultRemoveFriend >( this, FRIEND_INVALID );
 	}
 
-	user->m_friendList.erase( iter );
+	UserManager::Get().UnwatchFriend( user, m_chatHandle );
 
 	return std::make_shared< ResultRemoveFriend >( this, SUCCESS );
 }
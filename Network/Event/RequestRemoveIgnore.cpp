@@ -1,6 +1,6 @@
 #include "RequestRemoveIgnore.h"
 
-#include "../../Game/RealmUserManager.h"
+#include "../../Game/RealmUser.h"
 #include "../../Database/Database.h"
 #include "../../logging.h"
 
@@ -14,9 +14,7 @@ void RequestRemoveIgnore::Deserialize( sptr_byte_stream stream )
 
 sptr_generic_response RequestRemoveIgnore::ProcessRequest( sptr_socket socket, sptr_byte_stream stream )
 {
-	Deserialize( stream );
-
-	auto user = UserManager::Get().FindUserBySocket( socket );
+	auto user = socket->user.lock();
 	if( user == nullptr )
 	{
 		return std::make_shared< ResultRemoveIgnore >( this, FATAL_ERROR );
@@ -32,13 +30,11 @@ sptr_generic_response RequestRemoveIgnore::ProcessRequest( sptr_socket socket, s
 		return std::make_shared< ResultRemoveIgnore >( this, DATABASE_ERROR );
 	}
 
-	const auto iter = std::find( user->m_ignoreList.begin(), user->m_ignoreList.end(), m_chatHandle );
-	if( iter == user->m_ignoreList.end() )
+	if( !user->RemoveIgnore( m_chatHandle ) )
 	{
 		return std::make_shared< ResultRemoveIgnore >( this, IGNORE_INVALID );
 	}
 
-	user->m_ignoreList.erase( iter );
 
 	return std::make_shared< ResultRemoveIgnore >( this, SUCCESS );
 }
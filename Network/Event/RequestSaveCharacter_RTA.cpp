@@ -28,11 +28,9 @@ void RequestSaveCharacter_RTA::Deserialize( sptr_byte_stream stream )
 
 sptr_generic_response RequestSaveCharacter_RTA::ProcessRequest( sptr_socket socket, sptr_byte_stream stream )
 {
-	Deserialize( stream );
-
 	auto &userManager = UserManager::Get();
 
-	auto user = userManager.FindUserBySocket( socket );
+	auto user = socket->user.lock();
 	if( user == nullptr || user->m_accountId == -1 )
 	{
 		return std::make_shared< ResultSaveCharacter_RTA >( this, FATAL_ERROR );
@@ -16,9 +16,7 @@ void RequestSendInstantMessage::Deserialize( sptr_byte_stream stream )
 
 sptr_generic_response RequestSendInstantMessage::ProcessRequest( sptr_socket socket, sptr_byte_stream stream )
 {
-	Deserialize( stream );
-
-	const auto user = UserManager::Get().FindUserBySocket( socket );
+	const auto user = socket->user.lock();
 	if( !user )
 	{
 		Log::Error( "User not found for socket!" );
@@ -31,7 +29,7 @@ sptr_generic_response RequestSendInstantMessage::ProcessRequest( sptr_socket soc
 		return std::make_shared< ResultSendInstantMessage >( this, GENERAL_ERROR );
 	}
 
-	if( targetUser->IsIgnored( user->m_chatHandle ) )
+	if( targetUser->IsIgnored( user->m_chatHandleId ) )
 	{
 		return std::make_shared< ResultSendInstantMessage >( this, USER_IGNORED );
 	}
@@ -1,6 +1,5 @@
 #include "RequestSendRoomMessage.h"
 
-#include "../../Game/RealmUserManager.h"
 #include "../../Game/ChatRoomManager.h"
 
 #include "NotifyRoomMessage.h"
@@ -17,9 +16,7 @@ void RequestSendRoomMessage::Deserialize( sptr_byte_stream stream )
 
 sptr_generic_response RequestSendRoomMessage::ProcessRequest( sptr_socket socket, sptr_byte_stream stream )
 {
-	Deserialize( stream );
-
-	const auto user = UserManager::Get().FindUserBySocket( socket );
+	const auto user = socket->user.lock();
 	if( !user )
 	{
 		Log::Error( "User not found for socket!" );
@@ -48,7 +45,7 @@ sptr_generic_response RequestSendRoomMessage::ProcessRequest( sptr_socket socket
 		if( !memberUser )
 			continue; 
 
-		if( memberUser->IsIgnored( user->m_chatHandle ) )
+		if( memberUser->IsIgnored( user->m_chatHandleId ) )
 		{
 			continue; // Skip sending to ignored users
 		}
@@ -1,6 +1,5 @@
 #include "RequestStartGame.h"
 
-#include "../../Game/RealmUserManager.h"
 #include "../../Game/GameSessionManager.h"
 #include "../../Game/ChatRoomManager.h"
 #include "../../Game/RealmUser.h"
@@ -15,9 +14,7 @@ void RequestStartGame::Deserialize( sptr_byte_stream stream )
 
 sptr_generic_response RequestStartGame::ProcessRequest( sptr_socket socket, sptr_byte_stream stream )
 {
-	Deserialize( stream );
-
-	auto user = UserManager::Get().FindUserBySocket( socket );
+	auto user = socket->user.lock();
 	if( user == nullptr )
 	{
 		return std::make_shared< ResultStartGame >( this, FATAL_ERROR );
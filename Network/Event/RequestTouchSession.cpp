@@ -1,6 +1,6 @@
 #include "RequestTouchSession.h"
 
-#include "../../Game/RealmUserManager.h"
+#include "../../Game/RealmUser.h"
 #include "../../logging.h"
 
 void RequestTouchSession::Deserialize( sptr_byte_stream stream )
@@ -12,9 +12,7 @@ void RequestTouchSession::Deserialize( sptr_byte_stream stream )
 
 sptr_generic_response RequestTouchSession::ProcessRequest( sptr_socket socket, sptr_byte_stream stream )
 {
-	Deserialize( stream );
-
-	auto user = UserManager::Get().FindUserBySocket( socket );
+	auto user = socket->user.lock();
 
 	if( user == nullptr )
 	{
@@ -1,6 +1,5 @@
 #include "RequestUpdateGameData.h"
 
-#include "../../Game/RealmUserManager.h"
 #include "../../Game/GameSessionManager.h"
 #include "../../Game/RealmUser.h"
 #include "../../logging.h"
@@ -45,9 +44,7 @@ bool RequestUpdateGameData::ParseGameData( sptr_game_session session )
 
 sptr_generic_response RequestUpdateGameData::ProcessRequest( sptr_socket socket, sptr_byte_stream stream )
 {
-	Deserialize( stream );
-
-	auto user = UserManager::Get().FindUserBySocket( socket );
+	auto user = socket->user.lock();
 
 	if( user == nullptr )
 	{
@@ -63,6 +60,8 @@ sptr_generic_response RequestUpdateGameData::ProcessRequest( sptr_socket socket,
 		return std::make_shared< ResultUpdateGameData >( this );
 	}
 
+	GameSessionManager::Get().OnGameUpdated( gameSession, user->m_gameType );
+
 	const auto localAddr = std::string( m_gameData.c_str() + 220, 24 );
 	user->m_localAddr = localAddr;
 
@@ -1,7 +1,6 @@
 #include "RequestUserJoinSuccess.h"
 
 #include "../../Game/GameSessionManager.h"
-#include "../../Game/RealmUserManager.h"
 #include "../../Game/RealmUser.h"
 #include "../../Database/Database.h"
 #include "../../logging.h"
@@ -16,9 +15,7 @@ void RequestUserJoinSuccess::Deserialize( sptr_byte_stream stream )
 
 sptr_generic_response RequestUserJoinSuccess::ProcessRequest( sptr_socket socket, sptr_byte_stream stream )
 {
-	Deserialize( stream );
-
-	auto user = UserManager::Get().FindUserBySocket( socket );
+	auto user = socket->user.lock();
 	if( user == nullptr )
 	{
 		return std::make_shared< ResultUserJoinSuccess >( this, FATAL_ERROR );
@@ -43,6 +40,8 @@ sptr_generic_response RequestUserJoinSuccess::ProcessRequest( sptr_socket socket
 		return std::make_shared< ResultUserJoinSuccess >( this, FATAL_ERROR );
 	}
 
+	GameSessionManager::Get().OnGameUpdated( gameSession, user->m_gameType );
+
 	return std::make_shared< ResultUserJoinSuccess >( this, SUCCESS );
 }
 
@@ -1,7 +1,9 @@
 #pragma once
 
-#include <map>
-#include <functional>
+#include <array>
+#include <cstdint>
+
+#include "RequestPool.h"
 
 /* 0001 */	#include "Event/RequestAddFriend.h"
 /* 0002 */	#include "Event/RequestAddIgnore.h"
@@ -59,211 +61,60 @@
 /* 0066 */	#include "Event/RequestDoClientDiscovery_RTA.h"
 
 
-const std::map< int16_t, std::function< std::unique_ptr< GenericRequest >() > > REQUEST_EVENT =
+// Highest opcode the lobby will dispatch. Anything above is rejected before
+// the table is touched.
+constexpr uint16_t MAX_REQUEST_ID = 0x0066;
+
+using RequestTable = std::array< RequestHandler, MAX_REQUEST_ID + 1 >;
+
+consteval RequestTable BuildRequestTable()
 {
-	{ 0x0001, []() -> std::unique_ptr< GenericRequest >
-		{
-			return std::make_unique< RequestAddFriend >();
-		}
-	},
-	{ 0x0002, []() -> std::unique_ptr< GenericRequest >
-		{
-			return std::make_unique< RequestAddIgnore >();
-		}
-	},
-	{ 0x0005, []() -> std::unique_ptr< GenericRequest >
-		{
-			return std::make_unique< RequestCancelGame >();
-		}
-	},
-	{ 0x0006, []() -> std::unique_ptr< GenericRequest >
-		{
-			return std::make_unique< RequestCreateAccount >();
-		}
-	},
-	{ 0x0008, []() -> std::unique_ptr< GenericRequest >
-		{
-			return std::make_unique< RequestCreatePrivateGame >();
-		}
-	},
-	{ 0x0009, []() -> std::unique_ptr< GenericRequest >
-		{
-			return std::make_unique< RequestCreatePrivateRoom >();
-		}
-	},
-	{ 0x000A, []() -> std::unique_ptr< GenericRequest >
-		{
-			return std::make_unique< RequestCreatePublicGame >();
-		}
-	},
-	{ 0x000C, []() -> std::unique_ptr< GenericRequest >
-		{
-			return std::make_unique< RequestEnterRoom >();
-		}
-	},
-	{ 0x000D, []() -> std::unique_ptr< GenericRequest >
-		{
-			return std::make_unique< RequestGetGame >();
-		}
-	},
-	{ 0x000E, []() -> std::unique_ptr< GenericRequest >
-		{
-			return std::make_unique< RequestGetPublicRooms >();
-		}
-	},
-	{ 0x000F, []() -> std::unique_ptr< GenericRequest >
-		{
-			return std::make_unique< RequestGetRealmStats >();
-		}
-	},
-	{ 0x0011, []() -> std::unique_ptr< GenericRequest >
-		{
-			return std::make_unique< RequestGetRoom >();
-		}
-	},
-	{ 0x0015, []() -> std::unique_ptr< GenericRequest >
-		{
-			return std::make_unique< RequestLeaveRoom >();
-		}
-	},
-	{ 0x0016, []() -> std::unique_ptr< GenericRequest >
-		{
-			return std::make_unique< RequestLogin >();
-		}
-	},
-	{ 0x0017, []() -> std::unique_ptr< GenericRequest >
-		{
-			return std::make_unique< RequestLogout >();
-		}
-	},
-	{ 0x0018, []() -> std::unique_ptr< GenericRequest >
-		{
-			return std::make_unique< RequestMatchGame >();
-		}
-	},
-	{ 0x001C, []() -> std::unique_ptr< GenericRequest >
-		{
-			return std::make_unique< RequestRemoveFriend >();
-		}
-	},
-	{ 0x001D, []() -> std::unique_ptr< GenericRequest >
-		{
-			return std::make_unique< RequestRemoveIgnore >();
-		}
-	},
-	{ 0x0021, []() -> std::unique_ptr< GenericRequest >
-		{
-			return std::make_unique< RequestSendInstantMessage >();
-		}
-	},
-	{ 0x0022, []() -> std::unique_ptr< GenericRequest >
-		{
-			return std::make_unique< RequestSendRoomMessage >();
-		}
-	},
-	{ 0x0023, []() -> std::unique_ptr< GenericRequest >
-		{
-			return std::make_unique< RequestStartGame >();
-		}
-	},
-	{ 0x0024, []() -> std::unique_ptr< GenericRequest >
-		{
-			return std::make_unique< RequestTouchSession >();
-		}
-	},
-	{ 0x0025, []() -> std::unique_ptr< GenericRequest >
-		{
-			return std::make_unique< RequestDoClientDiscovery >();
-		}
-	},
-	{ 0x0027, []() -> std::unique_ptr< GenericRequest >
-		{
-			return std::make_unique< RequestGetEncryptionKey >();
-		}
-	},
-	{ 0x0042, []() -> std::unique_ptr< GenericRequest >
-		{
-			return std::make_unique< RequestGetRules >();
-		}
-	},
-	{ 0x0043, []() -> std::unique_ptr< GenericRequest >
-		{
-			return std::make_unique< RequestGetServerAddress >();
-		}
-	},
-	{ 0x0044, []() -> std::unique_ptr< GenericRequest >
-		{
-			return std::make_unique< RequestUpdateGameData >();
-		}
-	},
-	{ 0x0054, []() -> std::unique_ptr< GenericRequest >
-		{
-			return std::make_unique< RequestCreatePublicGame_RTA >();
-		}
-	},
-	{ 0x0055, []() -> std::unique_ptr< GenericRequest >
-		{
-			return std::make_unique< RequestMatchGame_RTA >();
-		}
-	},
-	{ 0x0056, []() -> std::unique_ptr< GenericRequest >
-		{
-			return std::make_unique< RequestCreatePrivateGame_RTA >();
-		}
-	},
-	{ 0x0057, []() -> std::unique_ptr< GenericRequest >
-		{
-			return std::make_unique< RequestGetGame_RTA >();
-		}
-	},
-	{ 0x0058, []() -> std::unique_ptr< GenericRequest >
-		{
-			return std::make_unique< RequestCreateNewCharacter_RTA >();
-		}
-	},
-	{ 0x005B, []() -> std::unique_ptr< GenericRequest >
-		{
-			return std::make_unique< RequestGetNetCharacterList_RTA >();
-		}
-	},
-	{ 0x005C, []() -> std::unique_ptr< GenericRequest >
-		{
-			return std::make_unique< RequestGetNetCharacterData_RTA >();
-		}
-	},
-	{ 0x005D, []() -> std::unique_ptr< GenericRequest >
-		{
-			return std::make_unique< RequestAppendCharacterData >();
-		}
-	},
-	{ 0x005E, []() -> std::unique_ptr< GenericRequest >
-		{
-			return std::make_unique< RequestSaveCharacter_RTA >();
-		}
-	},
-	{ 0x005F, []() -> std::unique_ptr< GenericRequest >
-		{
-			return std::make_unique< RequestUserJoinSuccess >();
-		}
-	},
-	{ 0x0060, []() -> std::unique_ptr< GenericRequest >
-		{
-			return std::make_unique< RequestCancelGame_RTA >();
-		}
-	},
-	{ 0x0061, []() -> std::unique_ptr< GenericRequest >
-		{
-			return std::make_unique< RequestGetSocialListInitial >();
-		}
-	},
-	{ 0x0062, []() -> std::unique_ptr< GenericRequest >
-		{
-			return std::make_unique< RequestGetSocialListUpdate >();
-		}
-	},
-	{ 0x0066, []() -> std::unique_ptr< GenericRequest >
-		{
-			return std::make_unique< RequestDoClientDiscovery_RTA >();
-		}
-	},
-};
\ No newline at end of file
+	RequestTable table{};
+
+	table[ 0x0001 ] = &RequestPool< RequestAddFriend >::Dispatch;
+	table[ 0x0002 ] = &RequestPool< RequestAddIgnore >::Dispatch;
+	table[ 0x0005 ] = &RequestPool< RequestCancelGame >::Dispatch;
+	table[ 0x0006 ] = &RequestPool< RequestCreateAccount >::Dispatch;
+	table[ 0x0008 ] = &RequestPool< RequestCreatePrivateGame >::Dispatch;
+	table[ 0x0009 ] = &RequestPool< RequestCreatePrivateRoom >::Dispatch;
+	table[ 0x000A ] = &RequestPool< RequestCreatePublicGame >::Dispatch;
+	table[ 0x000C ] = &RequestPool< RequestEnterRoom >::Dispatch;
+	table[ 0x000D ] = &RequestPool< RequestGetGame >::Dispatch;
+	table[ 0x000E ] = &RequestPool< RequestGetPublicRooms >::Dispatch;
+	table[ 0x000F ] = &RequestPool< RequestGetRealmStats >::Dispatch;
+	table[ 0x0011 ] = &RequestPool< RequestGetRoom >::Dispatch;
+	table[ 0x0015 ] = &RequestPool< RequestLeaveRoom >::Dispatch;
+	table[ 0x0016 ] = &RequestPool< RequestLogin >::Dispatch;
+	table[ 0x0017 ] = &RequestPool< RequestLogout >::Dispatch;
+	table[ 0x0018 ] = &RequestPool< RequestMatchGame >::Dispatch;
+	table[ 0x001C ] = &RequestPool< RequestRemoveFriend >::Dispatch;
+	table[ 0x001D ] = &RequestPool< RequestRemoveIgnore >::Dispatch;
+	table[ 0x0021 ] = &RequestPool< RequestSendInstantMessage >::Dispatch;
+	table[ 0x0022 ] = &RequestPool< RequestSendRoomMessage >::Dispatch;
+	table[ 0x0023 ] = &RequestPool< RequestStartGame >::Dispatch;
+	table[ 0x0024 ] = &RequestPool< RequestTouchSession >::Dispatch;
+	table[ 0x0025 ] = &RequestPool< RequestDoClientDiscovery >::Dispatch;
+	table[ 0x0027 ] = &RequestPool< RequestGetEncryptionKey >::Dispatch;
+	table[ 0x0042 ] = &RequestPool< RequestGetRules >::Dispatch;
+	table[ 0x0043 ] = &RequestPool< RequestGetServerAddress >::Dispatch;
+	table[ 0x0044 ] = &RequestPool< RequestUpdateGameData >::Dispatch;
+	table[ 0x0054 ] = &RequestPool< RequestCreatePublicGame_RTA >::Dispatch;
+	table[ 0x0055 ] = &RequestPool< RequestMatchGame_RTA >::Dispatch;
+	table[ 0x0056 ] = &RequestPool< RequestCreatePrivateGame_RTA >::Dispatch;
+	table[ 0x0057 ] = &RequestPool< RequestGetGame_RTA >::Dispatch;
+	table[ 0x0058 ] = &RequestPool< RequestCreateNewCharacter_RTA >::Dispatch;
+	table[ 0x005B ] = &RequestPool< RequestGetNetCharacterList_RTA >::Dispatch;
+	table[ 0x005C ] = &RequestPool< RequestGetNetCharacterData_RTA >::Dispatch;
+	table[ 0x005D ] = &RequestPool< RequestAppendCharacterData >::Dispatch;
+	table[ 0x005E ] = &RequestPool< RequestSaveCharacter_RTA >::Dispatch;
+	table[ 0x005F ] = &RequestPool< RequestUserJoinSuccess >::Dispatch;
+	table[ 0x0060 ] = &RequestPool< RequestCancelGame_RTA >::Dispatch;
+	table[ 0x0061 ] = &RequestPool< RequestGetSocialListInitial >::Dispatch;
+	table[ 0x0062 ] = &RequestPool< RequestGetSocialListUpdate >::Dispatch;
+	table[ 0x0066 ] = &RequestPool< RequestDoClientDiscovery_RTA >::Dispatch;
+
+	return table;
+}
+
+// Dense opcode -> handler table, empty slots are nullptr.
+constexpr RequestTable REQUEST_EVENT = BuildRequestTable();
\ No newline at end of file
@@ -15,8 +15,8 @@ using sptr_socket = std::shared_ptr< RealmSocket >;
 
 class GenericRequest {
 public:
-	int16_t m_packetId;
-	uint32_t m_trackId;
+	int16_t m_packetId = 0;
+	uint32_t m_trackId = 0;
 
 	virtual ~GenericRequest() = default;
 
@@ -32,11 +32,19 @@ public:
 
 	void DeserializeHeader( sptr_byte_stream stream )
 	{
+		if( !stream->require( 10 ) )
+		{
+			return;
+		}
+
 		m_packetId = stream->read_u16();
 		m_trackId = stream->read_u32();
 		auto version = stream->read_u32();	// 2 for CON and 6 for RTA
 	};
 
+	// Decodes the packet body. Must not throw; a short or malformed packet
+	// leaves the stream invalid and the request is dropped before
+	// ProcessRequest is called.
 	virtual void Deserialize( sptr_byte_stream stream ) = 0;
 };
 
@@ -10,6 +10,8 @@
 #include "GenericNetMessage.h"
 #include "../Common/Constant.h"
 
+class RealmUser;
+
 class RealmSocket
 {
 private:
@@ -64,6 +66,15 @@ public:
 
 	std::vector< uint8_t > m_pendingWriteBuffer;
 	std::vector< uint8_t > m_pendingReadBuffer;
+
+	// Encrypted session ID of the user on this connection, so incoming
+	// session IDs can be matched without decrypting them.
+	CachedCipherText session_cipher;
+
+	// User that owns this connection. Bound by UserManager::CreateUser and
+	// cleared when the user is removed, so handlers can identify the sender
+	// without going through the manager.
+	std::weak_ptr< RealmUser > user;
 };
 
 using sptr_socket = std::shared_ptr< RealmSocket >;
@@ -0,0 +1,62 @@
+#pragma once
+
+#include <memory>
+#include <vector>
+
+#include "GenericNetRequest.h"
+#include "../logging.h"
+
+// Signature of a dispatch table entry.
+using RequestHandler = sptr_generic_response ( * )( sptr_socket, sptr_byte_stream );
+
+// Per request type free-list. Requests are only dispatched from the lobby
+// thread, so the pool does not need to be locked. Objects are reset to a
+// default-constructed state before they are handed out again so stale
+// fields from a previous packet can never leak into the next one.
+template< typename T >
+class RequestPool
+{
+private:
+	static inline std::vector< std::unique_ptr< T > > m_freeList;
+
+	static std::unique_ptr< T > Acquire()
+	{
+		if( m_freeList.empty() )
+		{
+			return std::make_unique< T >();
+		}
+
+		auto request = std::move( m_freeList.back() );
+		m_freeList.pop_back();
+
+		return request;
+	}
+
+	static void Release( std::unique_ptr< T > request )
+	{
+		std::destroy_at( request.get() );
+		std::construct_at( request.get() );
+
+		m_freeList.push_back( std::move( request ) );
+	}
+
+public:
+	static sptr_generic_response Dispatch( sptr_socket socket, sptr_byte_stream stream )
+	{
+		auto request = Acquire();
+
+		request->Deserialize( stream );
+
+		if( !stream->is_valid() )
+		{
+			Log::Error( "[LOBBY] Malformed packet id : {}", request->m_packetId );
+			Release( std::move( request ) );
+			return nullptr;
+		}
+
+		auto response = request->ProcessRequest( socket, stream );
+		Release( std::move( request ) );
+
+		return response;
+	}
+};
\ No newline at end of file
@@ -0,0 +1,130 @@
+#include "StaticFrameCache.h"
+
+#include "../Common/ByteStream.h"
+#include "../Crypto/RealmCrypt.h"
+#include "../configuration.h"
+#include "../logging.h"
+
+static sptr_static_frame MakeFrame( const ByteBuffer &stream )
+{
+	return std::make_shared< const StaticFrame >( stream.m_buffer );
+}
+
+static sptr_static_frame BuildEncryptionKey()
+{
+	ByteBuffer stream;
+
+	auto symKey = RealmCrypt::getSymmetricKey();
+	auto encrypted = RealmCrypt::encryptSymmetric( symKey );
+
+	stream.write_u32( 0 );
+	stream.write_u32( static_cast< uint32_t >( encrypted.size() ) + 4 );
+	stream.write_u32( static_cast< uint32_t >( symKey.size() ) );
+	stream.write_bytes( encrypted );
+
+	return MakeFrame( stream );
+}
+
+static sptr_static_frame BuildRules( RealmGameType gameType )
+{
+	// TODO: Get rules/eula based on language
+	// and move it info a MOTD file.
+	std::wstring rules;
+
+	if( gameType == RealmGameType::RETURN_TO_ARMS )
+	{
+		rules = L"Welcome to the Champions Emulated Server!\n\n"
+			L"RETURN TO ARMS network support is currently a\n"
+			L"work in progress and can not guarantee stability.\n\n"
+			L"[IMPORTANT]:\n"
+			L"Please note that ONLINE character saves may be unstable.\n"
+			L"Use them at your own risk.\n";
+	}
+	else
+	{
+		rules = L"Welcome to the Champions Emulated Server!\n\n"
+			L"This server is currently in development\n"
+			L"and may not be fully functional.\n\n";
+	}
+
+	ByteBuffer stream;
+	stream.write_u32( 0 );
+	stream.write_utf16( rules );
+
+	return MakeFrame( stream );
+}
+
+static sptr_static_frame BuildServerAddress( RealmGameType gameType )
+{
+	ByteBuffer stream;
+	stream.write_u32( 0 );
+
+	if( gameType == RealmGameType::RETURN_TO_ARMS )
+	{
+		stream.write_utf8( Config::service_ip );
+		stream.write_i32( Config::rta_lobby_port );
+	}
+	else
+	{
+		stream.write_sz_utf8( Config::service_ip );
+		stream.write_i32( Config::con_lobby_port );
+	}
+
+	return MakeFrame( stream );
+}
+
+static sptr_static_frame BuildLoginTrailer()
+{
+	ByteBuffer stream;
+	stream.write_encrypted_utf16( L"UNKNOWN DUMMY STRING" );
+
+	return MakeFrame( stream );
+}
+
+void StaticFrameCache::Build()
+{
+	auto encryptionKey = BuildEncryptionKey();
+	auto loginTrailer = BuildLoginTrailer();
+
+	std::array< sptr_static_frame, 2 > rules;
+	std::array< sptr_static_frame, 2 > serverAddress;
+
+	for( auto gameType : { RealmGameType::CHAMPIONS_OF_NORRATH, RealmGameType::RETURN_TO_ARMS } )
+	{
+		rules[ gameType ] = BuildRules( gameType );
+		serverAddress[ gameType ] = BuildServerAddress( gameType );
+	}
+
+	std::lock_guard< std::mutex > lock( m_mutex );
+
+	m_encryptionKey = std::move( encryptionKey );
+	m_loginTrailer = std::move( loginTrailer );
+	m_rules = std::move( rules );
+	m_serverAddress = std::move( serverAddress );
+
+	Log::Debug( "Static response frames built" );
+}
+
+sptr_static_frame StaticFrameCache::GetEncryptionKey() const
+{
+	std::lock_guard< std::mutex > lock( m_mutex );
+	return m_encryptionKey;
+}
+
+sptr_static_frame StaticFrameCache::GetRules( RealmGameType gameType ) const
+{
+	std::lock_guard< std::mutex > lock( m_mutex );
+	return m_rules[ gameType ];
+}
+
+sptr_static_frame StaticFrameCache::GetServerAddress( RealmGameType gameType ) const
+{
+	std::lock_guard< std::mutex > lock( m_mutex );
+	return m_serverAddress[ gameType ];
+}
+
+sptr_static_frame StaticFrameCache::GetLoginTrailer() const
+{
+	std::lock_guard< std::mutex > lock( m_mutex );
+	return m_loginTrailer;
+}
\ No newline at end of file
@@ -0,0 +1,44 @@
+#pragma once
+
+#include <array>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include "../Common/Constant.h"
+
+using StaticFrame = std::vector< uint8_t >;
+using sptr_static_frame = std::shared_ptr< const StaticFrame >;
+
+// Pre-encoded response bodies that are the same for every client of a game
+// type. Results write their own packet and track ID, then copy the frame.
+class StaticFrameCache
+{
+public:
+	static StaticFrameCache &Get()
+	{
+		static StaticFrameCache instance;
+		return instance;
+	}
+
+	StaticFrameCache( const StaticFrameCache & ) = delete;
+	StaticFrameCache &operator=( const StaticFrameCache & ) = delete;
+	StaticFrameCache() = default;
+
+	// Encode every frame from the current configuration. Must be called
+	// after Config::Load and again whenever the configuration changes.
+	void Build();
+
+	sptr_static_frame GetEncryptionKey() const;
+	sptr_static_frame GetRules( RealmGameType gameType ) const;
+	sptr_static_frame GetServerAddress( RealmGameType gameType ) const;
+	sptr_static_frame GetLoginTrailer() const;
+
+private:
+	mutable std::mutex m_mutex;
+
+	sptr_static_frame m_encryptionKey;
+	std::array< sptr_static_frame, 2 > m_rules;
+	std::array< sptr_static_frame, 2 > m_serverAddress;
+	sptr_static_frame m_loginTrailer;
+};
\ No newline at end of file
@@ -7,6 +7,14 @@ bool Config::Load( std::string filename )
 	rta_lobby_port = 40910;
 	discovery_port = 10101;
 
+	crypto_worker_threads = 2;
+	crypto_queue_limit = 256;
+	password_hash_budget_ms = 25;
+
+	login_queue_limit = 512;
+	login_queue_per_address = 4;
+	login_queue_max_wait_ms = 5000;
+
 	// Read configuration from ini file
 	std::ifstream file( filename );
 	if( !file.is_open() )
@@ -48,6 +56,30 @@ bool Config::Load( std::string filename )
 		{
 			discovery_port = std::stoi( value );
 		}
+		else if( key == "crypto_worker_threads" )
+		{
+			crypto_worker_threads = std::stoi( value );
+		}
+		else if( key == "crypto_queue_limit" )
+		{
+			crypto_queue_limit = std::stoi( value );
+		}
+		else if( key == "password_hash_budget_ms" )
+		{
+			password_hash_budget_ms = std::stoi( value );
+		}
+		else if( key == "login_queue_limit" )
+		{
+			login_queue_limit = std::stoi( value );
+		}
+		else if( key == "login_queue_per_address" )
+		{
+			login_queue_per_address = std::stoi( value );
+		}
+		else if( key == "login_queue_max_wait_ms" )
+		{
+			login_queue_max_wait_ms = std::stoi( value );
+		}
 	}
 
 	return true;
@@ -12,4 +12,12 @@ public:
 	static inline uint16_t con_lobby_port;
 	static inline uint16_t rta_lobby_port;
 	static inline uint16_t discovery_port;
+
+	static inline uint32_t crypto_worker_threads;
+	static inline uint32_t crypto_queue_limit;
+	static inline uint32_t password_hash_budget_ms;
+
+	static inline uint32_t login_queue_limit;
+	static inline uint32_t login_queue_per_address;
+	static inline uint32_t login_queue_max_wait_ms;
 };
\ No newline at end of file
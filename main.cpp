@@ -7,7 +7,12 @@
 #include "logging.h"
 #include "configuration.h"
 #include "Database/Database.h"
+#include "Crypto/CryptoWorkerPool.h"
+#include "Crypto/PasswordHash.h"
+#include "Crypto/Sha256Simd.h"
+#include "Network/StaticFrameCache.h"
 #include "Lobby Server/LobbyServer.h"
+#include "Lobby Server/LoginQueue.h"
 #include "Discovery Server/DiscoveryServer.h"
 
 std::atomic< bool > g_isRunning( true );
@@ -66,6 +71,18 @@ int main()
 		return 0;
 	}
 
+	StaticFrameCache::Get().Build();
+	Log::Info( "Password hashing cost: {} iterations", CalibratePasswordIterations( Config::password_hash_budget_ms ) );
+	CryptoWorkerPool::Get().Start( Config::crypto_worker_threads, Config::crypto_queue_limit );
+
+	// Keep roughly one multi-buffer batch per worker in flight and hold
+	// the rest in the fair queue.
+	LoginQueue::Get().Configure(
+		Config::login_queue_limit,
+		Config::login_queue_per_address,
+		std::chrono::milliseconds( Config::login_queue_max_wait_ms ),
+		Config::crypto_worker_threads * Sha256Simd::LANES );
+
 	auto &lobby_server = LobbyServer::Get();
 	lobby_server.Start( Config::service_ip );
 
@@ -97,6 +114,7 @@ int main()
 
 	lobby_server.Stop();
 	discovery_server.Stop();
+	CryptoWorkerPool::Get().Stop();
 
 	return 0;
 }
\ No newline at end of file